@@ -4,13 +4,22 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/container/CallMap.cpp 
+../src/container/CallMap.cpp \
+../src/container/InternPool.cpp \
+../src/container/OodTransactionMap.cpp \
+../src/container/TimeoutWheel.cpp 
 
 OBJS += \
-./src/container/CallMap.o 
+./src/container/CallMap.o \
+./src/container/InternPool.o \
+./src/container/OodTransactionMap.o \
+./src/container/TimeoutWheel.o 
 
 CPP_DEPS += \
-./src/container/CallMap.d 
+./src/container/CallMap.d \
+./src/container/InternPool.d \
+./src/container/OodTransactionMap.d \
+./src/container/TimeoutWheel.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
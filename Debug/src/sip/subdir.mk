@@ -5,16 +5,19 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../src/sip/Call.cpp \
+../src/sip/RetransmissionFilter.cpp \
 ../src/sip/SipPacket.cpp \
 ../src/sip/SipProcessor.cpp 
 
 OBJS += \
 ./src/sip/Call.o \
+./src/sip/RetransmissionFilter.o \
 ./src/sip/SipPacket.o \
 ./src/sip/SipProcessor.o 
 
 CPP_DEPS += \
 ./src/sip/Call.d \
+./src/sip/RetransmissionFilter.d \
 ./src/sip/SipPacket.d \
 ./src/sip/SipProcessor.d 
 
@@ -4,25 +4,52 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/audio/AudioDecoderFactory.cpp \
 ../src/audio/AudioHandler.cpp \
 ../src/audio/G711Decoder.cpp \
+../src/audio/G722Decoder.cpp \
 ../src/audio/GsmDecoder.cpp \
+../src/audio/MemChunkPool.cpp \
 ../src/audio/PcmAudio.cpp \
-../src/audio/RtpSink.cpp 
+../src/audio/PcmResampler.cpp \
+../src/audio/RtpJitterBuffer.cpp \
+../src/audio/RtpPayloadStore.cpp \
+../src/audio/RtpSink.cpp \
+../src/audio/RtpStreamDecoder.cpp \
+../src/audio/StereoPcmMerger.cpp \
+../src/audio/VoiceActivityDetector.cpp 
 
 OBJS += \
+./src/audio/AudioDecoderFactory.o \
 ./src/audio/AudioHandler.o \
 ./src/audio/G711Decoder.o \
+./src/audio/G722Decoder.o \
 ./src/audio/GsmDecoder.o \
+./src/audio/MemChunkPool.o \
 ./src/audio/PcmAudio.o \
-./src/audio/RtpSink.o 
+./src/audio/PcmResampler.o \
+./src/audio/RtpJitterBuffer.o \
+./src/audio/RtpPayloadStore.o \
+./src/audio/RtpSink.o \
+./src/audio/RtpStreamDecoder.o \
+./src/audio/StereoPcmMerger.o \
+./src/audio/VoiceActivityDetector.o 
 
 CPP_DEPS += \
+./src/audio/AudioDecoderFactory.d \
 ./src/audio/AudioHandler.d \
 ./src/audio/G711Decoder.d \
+./src/audio/G722Decoder.d \
 ./src/audio/GsmDecoder.d \
+./src/audio/MemChunkPool.d \
 ./src/audio/PcmAudio.d \
-./src/audio/RtpSink.d 
+./src/audio/PcmResampler.d \
+./src/audio/RtpJitterBuffer.d \
+./src/audio/RtpPayloadStore.d \
+./src/audio/RtpSink.d \
+./src/audio/RtpStreamDecoder.d \
+./src/audio/StereoPcmMerger.d \
+./src/audio/VoiceActivityDetector.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,131 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * AudioDecoderFactory.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "AudioDecoderFactory.hpp"
+#include "G711Decoder.hpp"
+#include "GsmDecoder.hpp"
+#include "G722Decoder.hpp"
+#include "main/callx.hpp"
+
+using namespace std;
+
+namespace callx {
+
+void AudioDecoderRecycler::operator()(AudioDecoderInterface* decoder) {
+    if (decoder) {
+        AudioDecoderFactory::getInstance()->recycle(m_codec, decoder);
+    }
+}
+
+AudioDecoderFactory::AudioDecoderFactory()
+        : m_created(0),
+          m_pooled(0) {
+    L_t
+    << "C'tor";
+}
+
+AudioDecoderFactory::~AudioDecoderFactory() {
+    L_t
+    << "D'tor, deleting " << m_pooled << " pooled decoders.";
+    for (int codec = 0; codec <= ac_TELEPHONE_EVENT; codec++) {
+        for (auto iter = m_pool[codec].begin(); iter != m_pool[codec].end();
+                iter++) {
+            delete *iter;
+        }
+    }
+}
+
+AudioDecoderPtr AudioDecoderFactory::create(audioCodecEnum codec) {
+    {
+        lock_guard lock(m_mutex);
+        if (!m_pool[codec].empty()) {
+            AudioDecoderInterface* decoder = m_pool[codec].back();
+            m_pool[codec].pop_back();
+            m_pooled--;
+            return AudioDecoderPtr(decoder, AudioDecoderRecycler(codec));
+        }
+    }
+
+    AudioDecoderInterface* decoder = newDecoder(codec);
+    if (!decoder) {
+        return AudioDecoderPtr();
+    }
+
+    lock_guard lock(m_mutex);
+    m_created++;
+    return AudioDecoderPtr(decoder, AudioDecoderRecycler(codec));
+}
+
+void AudioDecoderFactory::recycle(audioCodecEnum codec,
+        AudioDecoderInterface* decoder) {
+    decoder->reset();
+
+    {
+        lock_guard lock(m_mutex);
+        if (m_pool[codec].size() < Max_Pooled) {
+            m_pool[codec].push_back(decoder);
+            m_pooled++;
+            return;
+        }
+        m_created--;
+    }
+    delete decoder;
+}
+
+size_t AudioDecoderFactory::created() const {
+    lock_guard lock(m_mutex);
+    return m_created;
+}
+
+size_t AudioDecoderFactory::pooled() const {
+    lock_guard lock(m_mutex);
+    return m_pooled;
+}
+
+bool AudioDecoderFactory::supports(audioCodecEnum codec) {
+    return codec == ac_PCMU || codec == ac_PCMA || codec == ac_GSM
+            || codec == ac_G722;
+}
+
+AudioDecoderInterface* AudioDecoderFactory::newDecoder(audioCodecEnum codec) {
+    switch (codec) {
+    case ac_PCMU:
+        return new G711Decoder(false);
+    case ac_PCMA:
+        return new G711Decoder(true);
+    case ac_GSM:
+        return new GsmDecoder();
+    case ac_G722:
+        return new G722Decoder();
+    default:
+        return NULL;
+    }
+}
+
+} /* namespace callx */
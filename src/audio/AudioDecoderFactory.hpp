@@ -0,0 +1,138 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * AudioDecoderFactory.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef AUDIODECODERFACTORY_HPP_
+#define AUDIODECODERFACTORY_HPP_
+
+#include <memory>
+#include <vector>
+#include "main/CallxSingleton.hpp"
+#include "main/CallxTypes.hpp"
+#include "AudioDecoderInterface.hpp"
+#include "audio.hpp"
+
+namespace callx {
+
+class AudioDecoderFactory;
+
+/**
+ * Deleter of the decoders created by the AudioDecoderFactory, it hands the
+ * decoder back to the pool of its codec.
+ */
+class AudioDecoderRecycler {
+public:
+
+    AudioDecoderRecycler()
+            : m_codec(ac_UNDEFINED) {
+    }
+
+    AudioDecoderRecycler(audioCodecEnum codec)
+            : m_codec(codec) {
+    }
+
+    void operator()(AudioDecoderInterface* decoder);
+
+private:
+    audioCodecEnum m_codec;
+};
+
+typedef std::unique_ptr<AudioDecoderInterface, AudioDecoderRecycler> AudioDecoderPtr;
+
+/**
+ * Creates the decoder of a codec for one media stream. Decoders with state
+ * (GSM) must not be shared between streams, so every stream gets its own
+ * instance. Returned decoders are reset and kept for the next stream, so
+ * streams do not create and destroy decoder objects after warm-up. The
+ * GSM decoder still allocates a new libgsm state on reset, see GsmDecoder.
+ */
+class AudioDecoderFactory:
+        public CallxSingleton<AudioDecoderFactory> {
+public:
+
+    // decoders kept per codec
+    static const size_t Max_Pooled = 1024;
+
+    /**
+     * Destructor, deletes the pooled decoders.
+     */
+    virtual ~AudioDecoderFactory();
+
+    /**
+     * @param codec
+     * @return A decoder in initial state, empty if the codec is not
+     * supported.
+     */
+    AudioDecoderPtr create(audioCodecEnum codec);
+
+    /**
+     * @param codec
+     * @return True, if there is a decoder for codec.
+     */
+    static bool supports(audioCodecEnum codec);
+
+    /**
+     * Resets the decoder and keeps it for reuse.
+     * @param codec
+     * @param decoder
+     */
+    void recycle(audioCodecEnum codec, AudioDecoderInterface* decoder);
+
+    /**
+     * Number of decoders allocated so far.
+     */
+    size_t created() const;
+
+    /**
+     * Number of decoders waiting for reuse.
+     */
+    size_t pooled() const;
+
+protected:
+
+    /**
+     * Hidden constructor
+     */
+    AudioDecoderFactory();
+
+    friend class CallxSingleton<AudioDecoderFactory> ;
+
+private:
+
+    // new decoder of the codec, NULL if not supported
+    static AudioDecoderInterface* newDecoder(audioCodecEnum codec);
+
+    std::vector<AudioDecoderInterface*> m_pool[ac_TELEPHONE_EVENT + 1];
+    size_t m_created;
+    size_t m_pooled;
+    mutable mutex m_mutex;
+};
+
+} /* namespace callx */
+
+#endif /* AUDIODECODERFACTORY_HPP_ */
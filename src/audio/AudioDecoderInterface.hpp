@@ -32,16 +32,49 @@
 #define AUDIODECODERINTERFACE_HPP_
 
 #include <cstddef>
+#include <sys/types.h>
 
 namespace callx {
 
 class AudioDecoderInterface {
 public:
+    AudioDecoderInterface()
+            : inBufSize(0),
+              outBufSize(0),
+              sampleRate(8000) {
+    }
+
     virtual ~AudioDecoderInterface() {
     }
     virtual void decode(void* inBuf, void* outBuf) = 0;
+
+    /**
+     * Returns to the initial state, before the decoder is used for another
+     * stream. Stateless decoders have nothing to do.
+     */
+    virtual void reset() {
+    }
+
+    /**
+     * Decodes a batch of frames with one call.
+     * @param in Encoded frames.
+     * @param inSize Size of in in bytes, a multiple of inBufSize.
+     * @param out Room for inSize / inBufSize * outBufSize bytes.
+     * @return Number of bytes written to out.
+     */
+    virtual size_t decode(const u_char* in, size_t inSize, short* out) {
+        size_t frames = inSize / inBufSize;
+        for (size_t frame = 0; frame < frames; frame++) {
+            decode(const_cast<u_char*>(in + frame * inBufSize),
+                    reinterpret_cast<char*>(out) + frame * outBufSize);
+        }
+        return frames * outBufSize;
+    }
     size_t inBufSize;
     size_t outBufSize;
+
+    // output samples per second
+    u_int sampleRate;
 };
 
 } /* namespace callx */
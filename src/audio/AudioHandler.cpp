@@ -36,40 +36,52 @@
 
 #include "container/CallDecodeQueue.hpp"
 #include "container/PcmAudioQueue.hpp"
-#include "container/TlayerPacketQueue.hpp"
 
 #include "network/SocketAddress.hpp"
-#include "network/TlayerPacket.hpp"
-#include "network/TlayerPacketRecycler.hpp"
 
 #include "RtpSink.hpp"
-#include "AudioDecoderInterface.hpp"
 #include "G711Decoder.hpp"
-#include "GsmDecoder.hpp"
+#include "RtpStreamDecoder.hpp"
+#include "RtpPayloadStore.hpp"
 #include "PcmAudio.hpp"
-#include "MemChunk.hpp"
+#include "StereoPcmMerger.hpp"
+#include "PcmResampler.hpp"
+#include "VoiceActivityDetector.hpp"
 
 using namespace std;
 
 namespace callx {
 
-u_int AudioHandler::rtpSeqNumError = 0;
+std::atomic<u_int> AudioHandler::rtpSeqNumError(0);
+std::atomic<uint64_t> AudioHandler::silenceRemovedMs(0);
+RtpStreamStats AudioHandler::rtpStreamStats;
+mutex AudioHandler::rtpStreamStatsMutex;
 
 AudioHandler::AudioHandler()
         : m_callDecodeQueue(CallDecodeQueue::getInstance()),
-          m_pcmAudioQueue(PcmAudioQueue::getInstance()),
-          m_tlayerPacketQueue(TlayerPacketQueue::getInstance()) {
+          m_pcmAudioQueue(PcmAudioQueue::getInstance()) {
 
     L_t
     << "C'tor";
     classname = "AudioHandler";
-
-    // instantiating audio decoder objects
-    m_audioDecoderMap[pt_PCMU] = new G711Decoder(false);
-    m_audioDecoderMap[pt_PCMA] = new G711Decoder(true);
-
-    // Currently not supported (bug...) (20130613)
-    //m_audioDecoderMap[pt_GSM] = new GsmDecoder();
+    if (m_callxConfig->wave_output_stereo)
+        m_stereoPcmMerger.reset(new StereoPcmMerger());
+    if (m_callxConfig->resample_rate) {
+        m_pcmResampler.reset(
+                new PcmResampler(m_callxConfig->resample_rate,
+                        m_callxConfig->resample_filter_length));
+        L_i
+        << "Resampling kernel: " << PcmResampler::kernelName();
+    }
+    if (m_callxConfig->use_vad) {
+        m_voiceActivityDetector.reset(
+                new VoiceActivityDetector(m_callxConfig->vad_threshold_db,
+                        m_callxConfig->vad_max_silence_ms));
+        L_i
+        << "VAD kernel: " << VoiceActivityDetector::kernelName();
+    }
+    L_i
+    << "G.711 decoding kernel: " << G711Decoder::kernelName();
 }
 
 AudioHandler::~AudioHandler() {
@@ -77,6 +89,11 @@ AudioHandler::~AudioHandler() {
     << "D'tor";
 }
 
+RtpStreamStats AudioHandler::getRtpStreamStats() {
+    lock_guard lock(rtpStreamStatsMutex);
+    return rtpStreamStats;
+}
+
 bool AudioHandler::stop() {
     L_t
     << "Overridden stop() has been called, deactivating CallDecodeQueue.";
@@ -112,27 +129,65 @@ void AudioHandler::worker() {
 
             m_currRtpSink = sinkMapIter->second;
 
-            // This queue contains the TlayerPackets (RTP) waiting to be
-            // decoded.
-            m_rtpPacketDeque = m_currRtpSink->getTlayerDeque();
+            // Streaming mode: the RTP packets have been decoded on arrival.
+            unique_ptr<RtpStreamDecoder> streamDecoder =
+                    m_currRtpSink->getStreamDecoder();
+            if (streamDecoder) {
+                pushPcmAudio(*streamDecoder);
+                continue;
+            }
 
-            decodeRtpPacketDeque();
+            // This store contains the RTP payloads waiting to be decoded.
+            m_rtpPayloadStore = m_currRtpSink->getPayloadStore();
+            if (m_rtpPayloadStore)
+                decodeRtpPayloadStore();
         }
+
+        if (m_stereoPcmMerger)
+            pushStereoPcmAudio();
     }
     L_t
     << "Stopped the worker because stop request is true.";
     m_stopped = true;
 }
 
-void AudioHandler::decodeRtpPacketDeque() {
-    unique_ptr<TlayerPacket, TlayerPacketRecycler> tlayerPacket;
-    rtpPayloadTypeEnum rtpPayloadType;
-    u_char* rtpPayloadData;
-    size_t rtpPayloadSize;
-    u_short rtpSeqNum = 0;
-    u_short rtpSeqNumPrev = 0;
-    auto memChunk = make_shared<MemChunk>(m_callxConfig->mem_chunk_size);
-    void* buffer = NULL;
+void AudioHandler::decodeRtpPayloadStore() {
+    RtpStreamDecoder decoder(m_callxConfig->wave_output_g711);
+    RtpPayloadStore::Reader reader(*m_rtpPayloadStore);
+    RtpPayload rtpPayload;
+    PayloadTypeMap payloadTypeMap = m_currRtpSink->getPayloadTypeMap();
+
+    // decode payload by payload...
+    while (reader.next(rtpPayload)) {
+        decoder.decode(payloadTypeMap, rtpPayload);
+    }
+    m_rtpPayloadStore.reset();
+
+    pushPcmAudio(decoder);
+}
+
+void AudioHandler::pushPcmAudio(RtpStreamDecoder& decoder) {
+    decoder.flush(m_currRtpSink->getPayloadTypeMap());
+    AudioHandler::rtpSeqNumError += decoder.seqNumErrors();
+
+    RtpStreamStats stats = decoder.stats();
+    {
+        lock_guard lock(rtpStreamStatsMutex);
+        AudioHandler::rtpStreamStats += stats;
+    }
+    if (stats.lost || stats.reordered || stats.duplicates || stats.late
+            || stats.ssrcChanges || stats.discarded) {
+        L_i
+        << "RTP stream of the "
+        << (m_currRtpSink->isCallerSink() ? "caller" : "callee")
+        << ", Call ID: " << m_currCall->getDialog()->callId
+        << ", lost: " << stats.lost
+        << ", reordered: " << stats.reordered
+        << ", duplicates: " << stats.duplicates
+        << ", late: " << stats.late
+        << ", SSRC changes: " << stats.ssrcChanges
+        << ", discarded: " << stats.discarded;
+    }
 
     unique_ptr<PcmAudio> pcmAudio(
             new PcmAudio(m_currCall->getDialog()->callId,
@@ -140,91 +195,49 @@ void AudioHandler::decodeRtpPacketDeque() {
                     m_currCall->getDialog()->callee,
                     m_currCall->getCreationTs(),
                     m_currRtpSink->isCallerSink()));
-    AudioDecoderInterface *audioDecoder;
-
-    // decode packet by packet...
-    for (auto iter = m_rtpPacketDeque->begin(); iter != m_rtpPacketDeque->end();
-            iter++) {
+    decoder.finish(*pcmAudio);
 
-        // getting ownership of TlayerPacket object (unique_ptr)
-        tlayerPacket = move(*iter);
+    // convert while the audio is still in the cache
+    if (m_pcmResampler)
+        m_pcmResampler->process(*pcmAudio);
 
-        // RTP header & payload
-        rtpPayloadType = static_cast<rtpPayloadTypeEnum>(tlayerPacket
-                ->m_udpPacket.payload[1] & 0x7F); // without marker-bit
-
-
-        // Currently not supported (bug...)! (20130614)
-        if(rtpPayloadType == pt_GSM) {
-            L_t << "GSM is currently not supported.";
-            continue;
-        }
-
-        rtpSeqNum = (tlayerPacket->m_udpPacket.payload[2] << 8)
-                | tlayerPacket->m_udpPacket.payload[3];
-        rtpPayloadData = tlayerPacket->m_udpPacket.payload + 12;
-        rtpPayloadSize = tlayerPacket->m_udpPacket.payloadLen - 12;
-
-        // DEBUG
-        if (rtpSeqNumPrev) {
-            if (rtpSeqNum != rtpSeqNumPrev + 1) {
-                AudioHandler::rtpSeqNumError++;
-                L_t << "seq num error, rtpSeqNumPrev="
-                     << rtpSeqNumPrev
-                     << " rtpSeqNum="
-                     << rtpSeqNum
-                     << endl;
-            }
-        }
-
-        if (rtpPayloadType != pt_PCMU && rtpPayloadType != pt_PCMA
-                && rtpPayloadType != pt_GSM) {
-            L_t
-            << "RTP payloadtype not supported: " << rtpPayloadType;
-            continue;
-        }
-
-        // get audio decoder
-        audioDecoder = m_audioDecoderMap[rtpPayloadType];
-
-        // RTP payload has to be greater than or equal to the decoder input
-        // buffer size.
-        if (audioDecoder->inBufSize > rtpPayloadSize) {
-            L_e
-            << "RTP payload smaller than decoder input buffer.";
-            continue;
-        }
-
-        // get pointer to store decoder output
-        if (!memChunk->declare(audioDecoder->outBufSize, &buffer)) {
-
-            // memory chunk seems to be full, push current memory chunk
-            pcmAudio->addChunk(memChunk);
-
-            // create new memory chunk
-            memChunk = make_shared<MemChunk>(m_callxConfig->mem_chunk_size);
-            if (!memChunk->declare(audioDecoder->outBufSize, &buffer)) {
-                L_f
-                << "Not able to store decoded audio in memory chunk. " << "Memory chunk too small?";
-                exit(EXIT_FAILURE);
-            }
-        }
-
-        // decode
-        audioDecoder->decode(rtpPayloadData, buffer);
-
-        // Push TlayerPacket back to the TlayerPacketQueue. Is this faster
-        // than relying on the TlayerPacketRecycler?
-        m_tlayerPacketQueue->push(move(tlayerPacket));
+    // push PcmAudio object into PcmAudioQueue if not empty
+    if (pcmAudio->getChunkDeque()->size() == 0)
+        return;
+    if (m_stereoPcmMerger) {
+        // merged with the other RtpSinks of the call, silence is removed
+        // from both channels at once
+        m_stereoPcmMerger->add(move(pcmAudio),
+                m_currRtpSink->getAudioStartTs(decoder));
+    } else {
+        if (m_voiceActivityDetector)
+            removeSilence(*pcmAudio);
+        if (pcmAudio->getChunkDeque()->size() > 0)
+            m_pcmAudioQueue->push(move(pcmAudio));
     }
+}
 
-    // push last memory chunk if it is not empty
-    if (memChunk->fillingLevel() > 0)
-        pcmAudio->addChunk(memChunk);
-
-    // push PcmAudio object into PcmAudioQueue if not empty
+void AudioHandler::pushStereoPcmAudio() {
+    unique_ptr<PcmAudio> pcmAudio(
+            new PcmAudio(m_currCall->getDialog()->callId,
+                    m_currCall->getDialog()->caller,
+                    m_currCall->getDialog()->callee,
+                    m_currCall->getCreationTs(),
+                    true));
+    if (!m_stereoPcmMerger->merge(*pcmAudio))
+        return;
+    if (m_voiceActivityDetector)
+        removeSilence(*pcmAudio);
     if (pcmAudio->getChunkDeque()->size() > 0)
         m_pcmAudioQueue->push(move(pcmAudio));
 }
 
+void AudioHandler::removeSilence(PcmAudio& pcmAudio) {
+    size_t removed = m_voiceActivityDetector->process(pcmAudio);
+    silenceRemovedMs += uint64_t(removed) * 1000 / pcmAudio.getSampleRate();
+    L_t
+    << "Call ID: " << pcmAudio.getCallId()
+    << ", silence removed: " << removed << " samples";
+}
+
 } /* namespace callx */
@@ -33,28 +33,29 @@
 
 #include "main/CallxThread.hpp"
 #include "main/CallxTypes.hpp"
+#include "audio.hpp"
+#include "RtpJitterBuffer.hpp"
+#include <atomic>
 
 namespace callx {
 
-enum rtpPayloadTypeEnum {
-    pt_PCMU = 0,
-    pt_GSM = 3,
-    pt_PCMA = 8,
-    pt_UNDEFINED = 127
-};
-
 class CallDecodeQueue;
 class Call;
 class RtpSink;
-class AudioDecoderInterface;
+class RtpStreamDecoder;
+class RtpPayloadStore;
 class PcmAudio;
 class PcmAudioQueue;
-class TlayerPacketQueue;
-
-typedef std::map<rtpPayloadTypeEnum, AudioDecoderInterface*> AudioDecoderMap;
+class StereoPcmMerger;
+class PcmResampler;
+class VoiceActivityDetector;
 
 /**
  * Audio Decoder Thread
+ *
+ * Several AudioHandler threads may pop calls from the CallDecodeQueue
+ * concurrently. Every thread decodes with its own RtpStreamDecoder objects,
+ * only the statistics below are shared.
  */
 class AudioHandler:
         public callx::CallxThread {
@@ -64,16 +65,51 @@ public:
     bool stop();
     void worker();
 
-    static u_int rtpSeqNumError;
+    static std::atomic<u_int> rtpSeqNumError;
+
+    // milliseconds of silence removed by the VAD
+    static std::atomic<uint64_t> silenceRemovedMs;
+
+    /**
+     * Returns the loss, reorder and duplicate counters summed over all
+     * decoded streams.
+     */
+    static RtpStreamStats getRtpStreamStats();
 
 protected:
-    void decodeRtpPacketDeque();
+    void decodeRtpPayloadStore();
+
+    /**
+     * Pushes the audio of the current RtpSink into the PcmAudioQueue and
+     * logs the loss, reorder and duplicate counters of the stream.
+     * @param decoder Stream decoder holding the decoded audio.
+     */
+    void pushPcmAudio(RtpStreamDecoder& decoder);
+
+    /**
+     * Pushes the audio of all RtpSinks of the current call, merged into one
+     * stereo PcmAudio (wave_output_stereo).
+     */
+    void pushStereoPcmAudio();
+
+    // drops or shortens the silence of the audio (use_vad)
+    void removeSilence(PcmAudio& pcmAudio);
+
+    static RtpStreamStats rtpStreamStats;
+    static mutex rtpStreamStatsMutex;
 
     CallDecodeQueue *m_callDecodeQueue;
-    AudioDecoderMap m_audioDecoderMap;
     PcmAudioQueue* m_pcmAudioQueue;
-    TlayerPacketQueue* m_tlayerPacketQueue;
-    std::unique_ptr<TlayerDeque> m_rtpPacketDeque;
+    std::unique_ptr<RtpPayloadStore> m_rtpPayloadStore;
+
+    // merges the RtpSinks of a call, if wave_output_stereo is set
+    std::unique_ptr<StereoPcmMerger> m_stereoPcmMerger;
+
+    // converts to resample_rate, if set
+    std::unique_ptr<PcmResampler> m_pcmResampler;
+
+    // removes silence, if use_vad is set
+    std::unique_ptr<VoiceActivityDetector> m_voiceActivityDetector;
 
     std::shared_ptr<Call> m_currCall;
     std::shared_ptr<RtpSinkMapType> m_currRtpSinkMap;
@@ -32,30 +32,245 @@
 #include "main/callx.hpp"
 #include <iostream>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define G711_X86_KERNELS
+#endif
+
 using namespace std;
 
 namespace callx {
 
+#ifdef G711_X86_KERNELS
+
+// The kernels expand the codes arithmetically (ITU-T G.711), the
+// exponent shift is a multiplication by a power of two from a byte shuffle.
+//
+// u-law: u = ~code, t = ((mantissa << 3) + 0x84) << exponent,
+//        sample = t - 0x84, negative if the sign bit of u is set
+// A-law: a = code ^ 0x55, t = (mantissa << 4) + 8 (+ 0x100 if exponent > 0)
+//        sample = t << (exponent - 1), negative if the sign bit of a is clear
+
+__attribute__((target("sse4.1")))
+static inline __m128i expandUlaw8(__m128i codes) {
+    const __m128i pow2 = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char) 128, 0,
+            0, 0, 0, 0, 0, 0, 0);
+    __m128i u = _mm_xor_si128(codes, _mm_set1_epi16(0xFF));
+    __m128i exponent = _mm_and_si128(_mm_srli_epi16(u, 4), _mm_set1_epi16(7));
+    __m128i mantissa = _mm_and_si128(u, _mm_set1_epi16(0x0F));
+    __m128i factor = _mm_shuffle_epi8(pow2,
+            _mm_or_si128(exponent, _mm_set1_epi16((short) 0x8000)));
+    __m128i t = _mm_mullo_epi16(
+            _mm_add_epi16(_mm_slli_epi16(mantissa, 3), _mm_set1_epi16(0x84)),
+            factor);
+    t = _mm_sub_epi16(t, _mm_set1_epi16(0x84));
+    __m128i negative = _mm_cmpeq_epi16(_mm_and_si128(u, _mm_set1_epi16(0x80)),
+            _mm_set1_epi16(0x80));
+    return _mm_blendv_epi8(t, _mm_sub_epi16(_mm_setzero_si128(), t),
+            negative);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i expandAlaw8(__m128i codes) {
+    const __m128i pow2 = _mm_setr_epi8(1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0, 0,
+            0, 0, 0, 0);
+    __m128i a = _mm_xor_si128(codes, _mm_set1_epi16(0x55));
+    __m128i exponent = _mm_and_si128(_mm_srli_epi16(a, 4), _mm_set1_epi16(7));
+    __m128i mantissa = _mm_and_si128(a, _mm_set1_epi16(0x0F));
+    __m128i factor = _mm_shuffle_epi8(pow2,
+            _mm_or_si128(exponent, _mm_set1_epi16((short) 0x8000)));
+    __m128i segment = _mm_andnot_si128(
+            _mm_cmpeq_epi16(exponent, _mm_setzero_si128()),
+            _mm_set1_epi16(0x100));
+    __m128i t = _mm_add_epi16(_mm_slli_epi16(mantissa, 4),
+            _mm_add_epi16(segment, _mm_set1_epi16(8)));
+    t = _mm_mullo_epi16(t, factor);
+    __m128i negative = _mm_cmpeq_epi16(_mm_and_si128(a, _mm_set1_epi16(0x80)),
+            _mm_setzero_si128());
+    return _mm_blendv_epi8(t, _mm_sub_epi16(_mm_setzero_si128(), t),
+            negative);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i expandUlaw16(__m256i codes) {
+    const __m256i pow2 = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char) 128,
+            0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, (char) 128, 0, 0,
+            0, 0, 0, 0, 0, 0);
+    __m256i u = _mm256_xor_si256(codes, _mm256_set1_epi16(0xFF));
+    __m256i exponent = _mm256_and_si256(_mm256_srli_epi16(u, 4),
+            _mm256_set1_epi16(7));
+    __m256i mantissa = _mm256_and_si256(u, _mm256_set1_epi16(0x0F));
+    __m256i factor = _mm256_shuffle_epi8(pow2,
+            _mm256_or_si256(exponent, _mm256_set1_epi16((short) 0x8000)));
+    __m256i t = _mm256_mullo_epi16(
+            _mm256_add_epi16(_mm256_slli_epi16(mantissa, 3),
+                    _mm256_set1_epi16(0x84)), factor);
+    t = _mm256_sub_epi16(t, _mm256_set1_epi16(0x84));
+    __m256i negative = _mm256_cmpeq_epi16(
+            _mm256_and_si256(u, _mm256_set1_epi16(0x80)),
+            _mm256_set1_epi16(0x80));
+    return _mm256_blendv_epi8(t, _mm256_sub_epi16(_mm256_setzero_si256(), t),
+            negative);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i expandAlaw16(__m256i codes) {
+    const __m256i pow2 = _mm256_setr_epi8(1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0,
+            0, 0, 0, 0, 0, 1, 1, 2, 4, 8, 16, 32, 64, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i a = _mm256_xor_si256(codes, _mm256_set1_epi16(0x55));
+    __m256i exponent = _mm256_and_si256(_mm256_srli_epi16(a, 4),
+            _mm256_set1_epi16(7));
+    __m256i mantissa = _mm256_and_si256(a, _mm256_set1_epi16(0x0F));
+    __m256i factor = _mm256_shuffle_epi8(pow2,
+            _mm256_or_si256(exponent, _mm256_set1_epi16((short) 0x8000)));
+    __m256i segment = _mm256_andnot_si256(
+            _mm256_cmpeq_epi16(exponent, _mm256_setzero_si256()),
+            _mm256_set1_epi16(0x100));
+    __m256i t = _mm256_add_epi16(_mm256_slli_epi16(mantissa, 4),
+            _mm256_add_epi16(segment, _mm256_set1_epi16(8)));
+    t = _mm256_mullo_epi16(t, factor);
+    __m256i negative = _mm256_cmpeq_epi16(
+            _mm256_and_si256(a, _mm256_set1_epi16(0x80)),
+            _mm256_setzero_si256());
+    return _mm256_blendv_epi8(t, _mm256_sub_epi16(_mm256_setzero_si256(), t),
+            negative);
+}
+
+__attribute__((target("sse4.1")))
+static void expandUlawSse41(const short* decodeTab, const u_char* in,
+        size_t n, short* out) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i codes = _mm_cvtepu8_epi16(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                expandUlaw8(codes));
+    }
+    G711Decoder::expandScalar(decodeTab, in + i, n - i, out + i);
+}
+
+__attribute__((target("sse4.1")))
+static void expandAlawSse41(const short* decodeTab, const u_char* in,
+        size_t n, short* out) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i codes = _mm_cvtepu8_epi16(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                expandAlaw8(codes));
+    }
+    G711Decoder::expandScalar(decodeTab, in + i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+static void expandUlawAvx2(const short* decodeTab, const u_char* in,
+        size_t n, short* out) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i codes = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                expandUlaw16(codes));
+    }
+    G711Decoder::expandScalar(decodeTab, in + i, n - i, out + i);
+}
+
+__attribute__((target("avx2")))
+static void expandAlawAvx2(const short* decodeTab, const u_char* in,
+        size_t n, short* out) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i codes = _mm256_cvtepu8_epi16(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                expandAlaw16(codes));
+    }
+    G711Decoder::expandScalar(decodeTab, in + i, n - i, out + i);
+}
+
+#endif
+
+// kernels of both laws, selected once by the CPU features
+struct G711Kernels {
+    G711Decoder::Kernel ulaw;
+    G711Decoder::Kernel alaw;
+    const char* name;
+};
+
+static const G711Kernels& g711Kernels() {
+    static const G711Kernels kernels = []() {
+#ifdef G711_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return G711Kernels { expandUlawAvx2, expandAlawAvx2, "avx2" };
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return G711Kernels { expandUlawSse41, expandAlawSse41, "sse4.1" };
+        }
+#endif
+        return G711Kernels { G711Decoder::expandScalar,
+                G711Decoder::expandScalar, "scalar" };
+    }();
+    return kernels;
+}
+
 G711Decoder::G711Decoder(bool alaw) {
     if (alaw) {
         decodeTab = alawDecodeTab;
+        m_kernel = g711Kernels().alaw;
     } else {
         decodeTab = ulawDecodeTab;
+        m_kernel = g711Kernels().ulaw;
     }
 
-    inBufSize = 160;
-    outBufSize = 320;
+    // G.711 has no framing, packets carry any number of samples
+    inBufSize = 1;
+    outBufSize = 2;
 }
 
 G711Decoder::~G711Decoder() {
-    L_i
+    L_t
     << "G711Decoder::~G711Decoder()";
 }
 
 void G711Decoder::decode(void* inBuf, void* outBuf) {
-    for (size_t i = 0; i < inBufSize; i++) {
-        reinterpret_cast<short*>(outBuf)[i] =
-                decodeTab[reinterpret_cast<unsigned char*>(inBuf)[i]];
+    m_kernel(decodeTab, reinterpret_cast<u_char*>(inBuf), inBufSize,
+            reinterpret_cast<short*>(outBuf));
+}
+
+size_t G711Decoder::decode(const u_char* in, size_t inSize, short* out) {
+    m_kernel(decodeTab, in, inSize, out);
+    return inSize * sizeof(short);
+}
+
+const char* G711Decoder::kernelName() {
+    return g711Kernels().name;
+}
+
+G711Decoder::Kernel G711Decoder::kernel(const std::string& name, bool alaw) {
+#ifdef G711_X86_KERNELS
+    __builtin_cpu_init();
+    if (name == "avx2" && __builtin_cpu_supports("avx2")) {
+        return alaw ? expandAlawAvx2 : expandUlawAvx2;
+    }
+    if (name == "sse4.1" && __builtin_cpu_supports("sse4.1")) {
+        return alaw ? expandAlawSse41 : expandUlawSse41;
+    }
+#endif
+    if (name == "scalar") {
+        return expandScalar;
+    }
+    return NULL;
+}
+
+const short* G711Decoder::decodeTable(bool alaw) {
+    return alaw ? alawDecodeTab : ulawDecodeTab;
+}
+
+void G711Decoder::expandScalar(const short* decodeTab, const u_char* in,
+        size_t n, short* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = decodeTab[in[i]];
     }
 }
 
@@ -31,18 +31,53 @@
 #ifndef G711DECODER_HPP_
 #define G711DECODER_HPP_
 
+#include <string>
 #include "AudioDecoderInterface.hpp"
 
 namespace callx {
 
+/**
+ * G.711 A-law and u-law decoder. The samples are expanded by a kernel
+ * selected once by the CPU features: AVX2, SSE4.1 or the scalar table
+ * lookup (e.g. for ARM).
+ */
 class G711Decoder: public AudioDecoderInterface {
 public:
     G711Decoder(bool alaw);
     ~G711Decoder();
     void decode(void* inBuf, void* outBuf);
+    size_t decode(const u_char* in, size_t inSize, short* out);
+
+    /**
+     * Name of the kernel used on this CPU.
+     * @return "avx2", "sse4.1" or "scalar".
+     */
+    static const char* kernelName();
+
+    // expands n samples, decodeTab is the table of the law
+    typedef void (*Kernel)(const short* decodeTab, const u_char* in,
+            size_t n, short* out);
+
+    static void expandScalar(const short* decodeTab, const u_char* in,
+            size_t n, short* out);
+
+    /**
+     * A kernel by name, regardless of the one in use, e.g. to compare it
+     * with the scalar one.
+     * @param name "avx2", "sse4.1" or "scalar".
+     * @param alaw
+     * @return NULL, if the kernel is not available on this CPU.
+     */
+    static Kernel kernel(const std::string& name, bool alaw);
+
+    /**
+     * Decoding table of the law, the reference of the kernels.
+     */
+    static const short* decodeTable(bool alaw);
 
 private:
     const short* decodeTab;
+    Kernel m_kernel;
     static const short alawDecodeTab[256];
     static const short ulawDecodeTab[256];
 
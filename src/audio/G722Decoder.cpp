@@ -0,0 +1,266 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The decoder is derived from the G.722 decoder (g722_decode.c) of
+ * Steve Underwood, as distributed with Asterisk, which carries the
+ * following notices:
+ *
+ * Copyright (C) 2005 Steve Underwood
+ *
+ *  Despite my general liking of the GPL, I place my own contributions
+ *  to this code in the public domain for the benefit of all mankind -
+ *  even the slimy ones who might try to proprietize my work and use it
+ *  to my detriment.
+ *
+ * Based on a single channel 64kbps only G.722 codec which is:
+ *
+ *   Copyright (c) CMU 1993
+ *   Computer Science, Speech Group
+ *   Chengxiang Lu and Alex Hauptmann
+ *
+ * The Carnegie Mellon ADPCM program is Copyright (c) 1993 by Carnegie
+ * Mellon University. Use of this program, for any research or commercial
+ * purpose, is completely unrestricted. If you make use of or redistribute
+ * this material, we would appreciate acknowledgement of its origin.
+ */
+
+/*
+ * G722Decoder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "G722Decoder.hpp"
+#include <cstring>
+
+namespace callx {
+
+static inline int saturate(int amp) {
+    if (amp > 32767)
+        return 32767;
+    if (amp < -32768)
+        return -32768;
+    return amp;
+}
+
+G722Decoder::G722Decoder() {
+    reset();
+
+    // no framing either, every byte carries two samples
+    inBufSize = 1;
+    outBufSize = 4;
+    sampleRate = 16000;
+}
+
+G722Decoder::~G722Decoder() {
+}
+
+void G722Decoder::reset() {
+    memset(m_band, 0, sizeof(m_band));
+    memset(m_x, 0, sizeof(m_x));
+    m_band[0].det = 32;
+    m_band[1].det = 8;
+}
+
+void G722Decoder::decode(void* inBuf, void* outBuf) {
+    decode(reinterpret_cast<u_char*>(inBuf), inBufSize,
+            reinterpret_cast<short*>(outBuf));
+}
+
+size_t G722Decoder::decode(const u_char* in, size_t inSize, short* out) {
+    for (size_t j = 0; j < inSize; j++) {
+        int ilow = in[j] & 0x3F;
+        int ihigh = (in[j] >> 6) & 0x03;
+
+        // low band: inverse quantizer (6 bit output, 4 bit prediction)
+        int wd1;
+        int wd2 = (m_band[0].det * qm6[ilow]) >> 15;
+        int rlow = m_band[0].s + wd2;
+        if (rlow > 16383)
+            rlow = 16383;
+        else if (rlow < -16384)
+            rlow = -16384;
+
+        int ril = ilow >> 2;
+        int dlow = (m_band[0].det * qm4[ril]) >> 15;
+
+        // low band: quantizer scale factor adaptation
+        wd1 = ((m_band[0].nb * 127) >> 7) + wl[rl42[ril]];
+        if (wd1 < 0)
+            wd1 = 0;
+        else if (wd1 > 18432)
+            wd1 = 18432;
+        m_band[0].nb = wd1;
+        wd1 = (m_band[0].nb >> 6) & 31;
+        wd2 = 8 - (m_band[0].nb >> 11);
+        m_band[0].det = (wd2 < 0 ? ilb[wd1] << -wd2 : ilb[wd1] >> wd2) << 2;
+
+        block4(m_band[0], dlow);
+
+        // high band: inverse quantizer
+        int dhigh = (m_band[1].det * qm2[ihigh]) >> 15;
+        int rhigh = dhigh + m_band[1].s;
+        if (rhigh > 16383)
+            rhigh = 16383;
+        else if (rhigh < -16384)
+            rhigh = -16384;
+
+        // high band: quantizer scale factor adaptation
+        wd1 = ((m_band[1].nb * 127) >> 7) + wh[rh2[ihigh]];
+        if (wd1 < 0)
+            wd1 = 0;
+        else if (wd1 > 22528)
+            wd1 = 22528;
+        m_band[1].nb = wd1;
+        wd1 = (m_band[1].nb >> 6) & 31;
+        wd2 = 10 - (m_band[1].nb >> 11);
+        m_band[1].det = (wd2 < 0 ? ilb[wd1] << -wd2 : ilb[wd1] >> wd2) << 2;
+
+        block4(m_band[1], dhigh);
+
+        // receive QMF, two output samples per input byte
+        memmove(m_x, m_x + 2, 22 * sizeof(int));
+        m_x[22] = rlow + rhigh;
+        m_x[23] = rlow - rhigh;
+
+        int xout1 = 0;
+        int xout2 = 0;
+        for (int i = 0; i < 12; i++) {
+            xout2 += m_x[2 * i] * qmfCoeffs[i];
+            xout1 += m_x[2 * i + 1] * qmfCoeffs[11 - i];
+        }
+        out[2 * j] = saturate(xout1 >> 11);
+        out[2 * j + 1] = saturate(xout2 >> 11);
+    }
+    return inSize * 2 * sizeof(short);
+}
+
+void G722Decoder::block4(Band& band, int d) {
+    int wd1;
+    int wd2;
+    int wd3;
+
+    // RECONS, PARREC
+    band.d[0] = d;
+    band.r[0] = saturate(band.s + d);
+    band.p[0] = saturate(band.sz + d);
+
+    // UPPOL2
+    for (int i = 0; i < 3; i++)
+        band.sg[i] = band.p[i] >> 15;
+    wd1 = saturate(band.a[1] << 2);
+    wd2 = (band.sg[0] == band.sg[1]) ? -wd1 : wd1;
+    if (wd2 > 32767)
+        wd2 = 32767;
+    wd3 = (wd2 >> 7) + ((band.sg[0] == band.sg[2]) ? 128 : -128);
+    wd3 += (band.a[2] * 32512) >> 15;
+    if (wd3 > 12288)
+        wd3 = 12288;
+    else if (wd3 < -12288)
+        wd3 = -12288;
+    band.ap[2] = wd3;
+
+    // UPPOL1
+    band.sg[0] = band.p[0] >> 15;
+    band.sg[1] = band.p[1] >> 15;
+    wd1 = (band.sg[0] == band.sg[1]) ? 192 : -192;
+    wd2 = (band.a[1] * 32640) >> 15;
+    band.ap[1] = saturate(wd1 + wd2);
+    wd3 = saturate(15360 - band.ap[2]);
+    if (band.ap[1] > wd3)
+        band.ap[1] = wd3;
+    else if (band.ap[1] < -wd3)
+        band.ap[1] = -wd3;
+
+    // UPZERO
+    wd1 = (d == 0) ? 0 : 128;
+    band.sg[0] = d >> 15;
+    for (int i = 1; i < 7; i++) {
+        band.sg[i] = band.d[i] >> 15;
+        wd2 = (band.sg[i] == band.sg[0]) ? wd1 : -wd1;
+        wd3 = (band.b[i] * 32640) >> 15;
+        band.bp[i] = saturate(wd2 + wd3);
+    }
+
+    // DELAYA
+    for (int i = 6; i > 0; i--) {
+        band.d[i] = band.d[i - 1];
+        band.b[i] = band.bp[i];
+    }
+    for (int i = 2; i > 0; i--) {
+        band.r[i] = band.r[i - 1];
+        band.p[i] = band.p[i - 1];
+        band.a[i] = band.ap[i];
+    }
+
+    // FILTEP
+    wd1 = saturate(band.r[1] + band.r[1]);
+    wd1 = (band.a[1] * wd1) >> 15;
+    wd2 = saturate(band.r[2] + band.r[2]);
+    wd2 = (band.a[2] * wd2) >> 15;
+    band.sp = saturate(wd1 + wd2);
+
+    // FILTEZ
+    band.sz = 0;
+    for (int i = 6; i > 0; i--) {
+        wd1 = saturate(band.d[i] + band.d[i]);
+        band.sz += (band.b[i] * wd1) >> 15;
+    }
+    band.sz = saturate(band.sz);
+
+    // PREDIC
+    band.s = saturate(band.sp + band.sz);
+}
+
+const int G722Decoder::qmfCoeffs[12] = { 3, -11, 12, 32, -210, 951, 3876,
+        -805, 362, -156, 53, -11 };
+
+const int G722Decoder::qm2[4] = { -7408, -1616, 7408, 1616 };
+
+const int G722Decoder::qm4[16] = { 0, -20456, -12896, -8968, -6288, -4240,
+        -2584, -1200, 20456, 12896, 8968, 6288, 4240, 2584, 1200, 0 };
+
+const int G722Decoder::qm6[64] = { -136, -136, -136, -136, -24808, -21904,
+        -19008, -16704, -14984, -13512, -12280, -11192, -10232, -9360, -8576,
+        -7856, -7192, -6576, -6000, -5456, -4944, -4464, -4008, -3576, -3168,
+        -2776, -2400, -2032, -1688, -1360, -1040, -728, 24808, 21904, 19008,
+        16704, 14984, 13512, 12280, 11192, 10232, 9360, 8576, 7856, 7192, 6576,
+        6000, 5456, 4944, 4464, 4008, 3576, 3168, 2776, 2400, 2032, 1688, 1360,
+        1040, 728, 432, 136, -432, -136 };
+
+const int G722Decoder::ilb[32] = { 2048, 2093, 2139, 2186, 2233, 2282, 2332,
+        2383, 2435, 2489, 2543, 2599, 2656, 2714, 2774, 2834, 2896, 2960, 3025,
+        3091, 3158, 3228, 3298, 3371, 3444, 3520, 3597, 3676, 3756, 3838, 3922,
+        4008 };
+
+const int G722Decoder::wl[8] = { -60, -30, 58, 172, 334, 538, 1198, 3042 };
+
+const int G722Decoder::rl42[16] = { 0, 7, 6, 5, 4, 3, 2, 1, 7, 6, 5, 4, 3, 2,
+        1, 0 };
+
+const int G722Decoder::wh[3] = { 0, -214, 798 };
+
+const int G722Decoder::rh2[4] = { 2, 1, 2, 1 };
+
+} /* namespace callx */
@@ -0,0 +1,93 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * G722Decoder.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef G722DECODER_HPP_
+#define G722DECODER_HPP_
+
+#include "AudioDecoderInterface.hpp"
+
+namespace callx {
+
+/**
+ * G.722 decoder (ITU-T G.722, 64 kbit/s mode), self-contained. Every byte
+ * carries a low band and a high band sample, the receive QMF turns them
+ * into two samples at 16 kHz.
+ *
+ * Derived from the public domain G.722 code of Steve Underwood and the
+ * CMU 1993 G.722 codec, see the notices in G722Decoder.cpp.
+ */
+class G722Decoder: public AudioDecoderInterface {
+public:
+    G722Decoder();
+    ~G722Decoder();
+    void decode(void* inBuf, void* outBuf);
+    size_t decode(const u_char* in, size_t inSize, short* out);
+    void reset();
+
+private:
+
+    // ADPCM state of one sub-band
+    struct Band {
+        int s;
+        int sp;
+        int sz;
+        int r[3];
+        int a[3];
+        int ap[3];
+        int p[3];
+        int d[7];
+        int b[7];
+        int bp[7];
+        int sg[7];
+        int nb;
+        int det;
+    };
+
+    // adaptive predictor update of a sub-band (block 4)
+    static void block4(Band& band, int d);
+
+    Band m_band[2];
+
+    // receive QMF delay line
+    int m_x[24];
+
+    static const int qmfCoeffs[12];
+    static const int qm2[4];
+    static const int qm4[16];
+    static const int qm6[64];
+    static const int ilb[32];
+    static const int wl[8];
+    static const int rl42[16];
+    static const int wh[3];
+    static const int rh2[4];
+};
+
+} /* namespace callx */
+
+#endif /* G722DECODER_HPP_ */
@@ -34,20 +34,43 @@ using namespace callx;
 
 #include "GsmDecoder.hpp"
 #include "main/callx.hpp"
+#include <cstring>
 
 namespace callx {
 
 GsmDecoder::GsmDecoder() {
     gsmState = gsm_create();
+    if (!gsmState) {
+        L_e
+        << "gsm_create() failed.";
+    }
     inBufSize = 33;
-    outBufSize = 160;
+    outBufSize = 320;
 }
 
 GsmDecoder::~GsmDecoder() {
-    gsm_destroy(gsmState);
+    if (gsmState) {
+        gsm_destroy(gsmState);
+    }
+}
+
+void GsmDecoder::reset() {
+    // libgsm has no public reset, so start over with a fresh state
+    if (gsmState) {
+        gsm_destroy(gsmState);
+    }
+    gsmState = gsm_create();
+    if (!gsmState) {
+        L_e
+        << "gsm_create() failed.";
+    }
 }
 
 void GsmDecoder::decode(void* inBuf, void* outBuf) {
+    if (!gsmState) {
+        memset(outBuf, 0, outBufSize);
+        return;
+    }
     gsm_decode(gsmState, reinterpret_cast<gsm_byte*>(inBuf),
             reinterpret_cast<gsm_signal*>(outBuf));
 }
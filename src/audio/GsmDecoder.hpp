@@ -34,17 +34,23 @@
 #include "AudioDecoderInterface.hpp"
 
 extern "C" {
-#include <gsm/private.h>
 #include <gsm/gsm.h>
 }
 
 namespace callx {
 
+/**
+ * GSM 06.10 decoder (libgsm). libgsm has no public reset and its state is
+ * opaque, so reset() replaces the state by a new one: a pooled GsmDecoder
+ * saves the decoder object, not the allocation of the libgsm state. If no
+ * state can be created, the decoder outputs silence.
+ */
 class GsmDecoder: public AudioDecoderInterface {
 public:
   GsmDecoder();
   ~GsmDecoder();
   void decode(void* inBuf, void* outBuf);
+  void reset();
 
 private:
   gsm gsmState;
@@ -31,13 +31,16 @@
 #ifndef MEMCHUNK_HPP_
 #define MEMCHUNK_HPP_
 
+#include <algorithm>
+
 namespace callx {
 
 /**
  * Offers an interface to manage a chunk of memory with configurable size on
  * initialization. The interface assists avoiding a buffer overrun.
  * However, it offers direct access to the memory to avoid unnecessary copies
- * of the data while filling the chunk.
+ * of the data while filling the chunk: declare() hands out the free space,
+ * commit() stores what has been written to it.
  */
 class MemChunk {
 public:
@@ -48,12 +51,10 @@ public:
      */
     MemChunk(size_t size)
             : m_data(NULL),
-              m_currDataPointer(NULL),
               m_size(size),
               m_fillingLevel(0) {
 
         m_data = new char[m_size];
-        m_currDataPointer = m_data;
     }
 
     /*
@@ -64,37 +65,47 @@ public:
     }
 
     /**
-     * Declares size bytes being stored in the chunk.
+     * Declares size bytes to be written into the chunk.
      * @param size The amount of bytes that are requested to add to the chunk.
-     * @param buffer If the return value is true, buffer points to the address
-     * where size additional bytes can be written.
-     * @return True if enough space is left to store size additional bytes in
-     * allocated memory.
+     * @param buffer Points to the address where the returned amount of bytes
+     * can be written.
+     * @return Bytes available at buffer, less than size if the chunk is
+     * nearly full and 0 if it is full. The rest goes into the next chunk.
      */
-    bool declare(size_t size, void** buffer) {
+    size_t declare(size_t size, void** buffer) {
+        *buffer = m_data + m_fillingLevel;
+        return std::min(size, m_size - m_fillingLevel);
+    }
 
-        // enough space left?
-        if (m_fillingLevel + size > m_size)
-            return false;
+    /**
+     * Stores size bytes written to the buffer handed out by declare().
+     * @param size At most the amount of bytes declare() returned.
+     */
+    void commit(size_t size) {
+        m_fillingLevel = std::min(m_fillingLevel + size, m_size);
+    }
 
-        // yes!
-        *buffer = m_currDataPointer;
-        m_fillingLevel += size;
-        m_currDataPointer += size;
-        return true;
+    /**
+     * Empties the chunk for reuse.
+     */
+    void clear() {
+        m_fillingLevel = 0;
     }
 
     size_t fillingLevel() {
         return m_fillingLevel;
     }
 
+    size_t size() const {
+        return m_size;
+    }
+
     void* data() {
         return m_data;
     }
 
 private:
     char* m_data;
-    char* m_currDataPointer;
     size_t m_size;
     size_t m_fillingLevel;
 };
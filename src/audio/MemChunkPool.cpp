@@ -0,0 +1,105 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * MemChunkPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "MemChunkPool.hpp"
+#include "config/CallxConfig.hpp"
+#include "main/callx.hpp"
+
+using namespace std;
+
+namespace callx {
+
+void MemChunkRecycler::operator()(MemChunk* memChunk) {
+    if (memChunk) {
+        MemChunkPool::getInstance()->recycle(memChunk);
+    }
+}
+
+MemChunkPool::MemChunkPool()
+        : m_chunkSize(CallxConfig::getInstance()->mem_chunk_size),
+          m_maxPooled(CallxConfig::getInstance()->mem_chunk_pool_size),
+          m_inUse(0) {
+    L_t
+    << "C'tor";
+}
+
+MemChunkPool::~MemChunkPool() {
+    L_t
+    << "D'tor, deleting " << m_pool.size() << " pooled chunks, "
+    << m_inUse << " still in use.";
+    for (auto iter = m_pool.begin(); iter != m_pool.end(); iter++) {
+        delete *iter;
+    }
+}
+
+shared_ptr<MemChunk> MemChunkPool::acquire() {
+    MemChunk* memChunk = NULL;
+    {
+        lock_guard lock(m_mutex);
+        m_inUse++;
+        if (!m_pool.empty()) {
+            memChunk = m_pool.back();
+            m_pool.pop_back();
+        }
+    }
+    if (!memChunk) {
+        memChunk = new MemChunk(m_chunkSize);
+    }
+    return shared_ptr<MemChunk>(memChunk, MemChunkRecycler());
+}
+
+void MemChunkPool::recycle(MemChunk* memChunk) {
+    memChunk->clear();
+
+    {
+        lock_guard lock(m_mutex);
+        m_inUse--;
+        if (m_pool.size() < m_maxPooled) {
+            m_pool.push_back(memChunk);
+            return;
+        }
+    }
+    delete memChunk;
+}
+
+size_t MemChunkPool::chunkSize() const {
+    return m_chunkSize;
+}
+
+size_t MemChunkPool::inUse() const {
+    lock_guard lock(m_mutex);
+    return m_inUse;
+}
+
+size_t MemChunkPool::pooled() const {
+    lock_guard lock(m_mutex);
+    return m_pool.size();
+}
+
+} /* namespace callx */
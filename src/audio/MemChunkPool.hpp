@@ -0,0 +1,111 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * MemChunkPool.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef MEMCHUNKPOOL_HPP_
+#define MEMCHUNKPOOL_HPP_
+
+#include <memory>
+#include <vector>
+#include "main/CallxSingleton.hpp"
+#include "main/CallxTypes.hpp"
+#include "MemChunk.hpp"
+
+namespace callx {
+
+/**
+ * Deleter of the MemChunks handed out by the MemChunkPool, it returns the
+ * chunk to the pool instead of freeing its memory.
+ */
+class MemChunkRecycler {
+public:
+    void operator()(MemChunk* memChunk);
+};
+
+/**
+ * Pool of MemChunks of mem_chunk_size bytes holding the decoded PCM data.
+ * A chunk goes back to the pool as soon as the last PcmAudio using it has
+ * been written by the OutputHandler, so after warm-up the audio path runs
+ * without heap allocations. At most mem_chunk_pool_size free chunks are
+ * kept, more are freed.
+ */
+class MemChunkPool:
+        public CallxSingleton<MemChunkPool> {
+public:
+
+    /**
+     * Destructor, deletes the free chunks.
+     */
+    virtual ~MemChunkPool();
+
+    /**
+     * @return An empty chunk, taken from the pool if possible.
+     */
+    std::shared_ptr<MemChunk> acquire();
+
+    /**
+     * Empties the chunk and keeps it for reuse.
+     * @param memChunk
+     */
+    void recycle(MemChunk* memChunk);
+
+    /**
+     * Size of the chunks in bytes.
+     */
+    size_t chunkSize() const;
+
+    /**
+     * Number of chunks handed out and not returned yet.
+     */
+    size_t inUse() const;
+
+    /**
+     * Number of free chunks waiting for reuse.
+     */
+    size_t pooled() const;
+
+protected:
+
+    /**
+     * Hidden constructor
+     */
+    MemChunkPool();
+
+    friend class CallxSingleton<MemChunkPool> ;
+
+private:
+    size_t m_chunkSize;
+    size_t m_maxPooled;
+    std::vector<MemChunk*> m_pool;
+    size_t m_inUse;
+    mutable mutex m_mutex;
+};
+
+} /* namespace callx */
+
+#endif /* MEMCHUNKPOOL_HPP_ */
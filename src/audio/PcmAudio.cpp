@@ -29,14 +29,17 @@
  */
 
 #include "PcmAudio.hpp"
+#include "MemChunkPool.hpp"
+#include <cstring>
+#include <algorithm>
 
 using namespace std;
 
 namespace callx {
 
 PcmAudio::PcmAudio(const string& callId,
-        const SipFromTo& caller,
-        const SipFromTo& callee,
+        const SipIdentity& caller,
+        const SipIdentity& callee,
         const systemClock::time_point& startTs,
         bool isCallerAudio)
         : m_callId(callId),
@@ -44,6 +47,9 @@ PcmAudio::PcmAudio(const string& callId,
           m_callee(callee),
           m_startTs(startTs),
           m_isCallerAudio(isCallerAudio),
+          m_sampleRate(8000),
+          m_channels(1),
+          m_encoding(ac_UNDEFINED),
           m_memChunkDeque(make_shared<MemChunkDeque>()) {
     L_t
             << "C'tor";
@@ -58,11 +64,11 @@ const std::string& PcmAudio::getCallId() const {
     return m_callId;
 }
 
-const SipFromTo& PcmAudio::getCaller() const {
+const SipIdentity& PcmAudio::getCaller() const {
     return m_caller;
 }
 
-const SipFromTo& PcmAudio::getCallee() const {
+const SipIdentity& PcmAudio::getCallee() const {
     return m_callee;
 }
 
@@ -78,6 +84,95 @@ bool PcmAudio::isCallerAudio() const {
     return m_isCallerAudio;
 }
 
+u_int PcmAudio::getSampleRate() const {
+    return m_sampleRate;
+}
+
+void PcmAudio::setSampleRate(u_int sampleRate) {
+    m_sampleRate = sampleRate;
+}
+
+u_short PcmAudio::getChannels() const {
+    return m_channels;
+}
+
+void PcmAudio::setChannels(u_short channels) {
+    m_channels = channels;
+}
+
+audioCodecEnum PcmAudio::getEncoding() const {
+    return m_encoding;
+}
+
+void PcmAudio::setEncoding(audioCodecEnum encoding) {
+    m_encoding = encoding;
+}
+
+void PcmAudio::append(const short* samples, size_t n) {
+    while (n > 0) {
+        void* buffer = NULL;
+        size_t count = 0;
+        if (!m_memChunkDeque->empty()) {
+            count = m_memChunkDeque->back()->declare(n * sizeof(short),
+                    &buffer) / sizeof(short);
+        }
+        if (!count) {
+            m_memChunkDeque->push_back(MemChunkPool::getInstance()->acquire());
+            count = m_memChunkDeque->back()->declare(n * sizeof(short),
+                    &buffer) / sizeof(short);
+        }
+        memcpy(buffer, samples, count * sizeof(short));
+        m_memChunkDeque->back()->commit(count * sizeof(short));
+        samples += count;
+        n -= count;
+    }
+}
+
+void PcmAudio::addSilence(size_t start, size_t length) {
+    if (!m_silence.empty()
+            && m_silence.back().first + m_silence.back().second == start) {
+        m_silence.back().second += length;
+    } else {
+        m_silence.push_back(make_pair(start, length));
+    }
+}
+
+size_t PcmAudio::voicedEnd(size_t voicedSamples) const {
+    size_t end = voicedSamples;
+    for (auto iter = m_silence.begin();
+            iter != m_silence.end() && iter->first < end; iter++) {
+        end += iter->second;
+    }
+    return end;
+}
+
+void PcmAudio::copyChannel(u_short channel, size_t maxSamples,
+        PcmAudio& pcmAudio) const {
+
+    // deinterleave, a sample group may span two chunks
+    vector<short> samples;
+    size_t index = 0;
+    for (auto iter = m_memChunkDeque->begin();
+            iter != m_memChunkDeque->end() && samples.size() < maxSamples;
+            iter++) {
+        const short* data = reinterpret_cast<const short*>((*iter)->data());
+        size_t n = (*iter)->fillingLevel() / sizeof(short);
+        for (size_t i = 0; i < n && samples.size() < maxSamples;
+                i++, index++) {
+            if (index % m_channels == channel)
+                samples.push_back(data[i]);
+        }
+    }
+    pcmAudio.append(samples.data(), samples.size());
+
+    // the silence spans count samples per channel already
+    for (auto iter = m_silence.begin();
+            iter != m_silence.end() && iter->first < samples.size(); iter++) {
+        pcmAudio.addSilence(iter->first,
+                min(iter->second, samples.size() - iter->first));
+    }
+}
+
 shared_ptr<MemChunkDeque> PcmAudio::getChunkDeque() {
     return m_memChunkDeque;
 }
@@ -32,7 +32,9 @@
 #define PCMAUDIO_HPP_
 
 #include "main/callx.hpp"
+#include "audio.hpp"
 #include "deque"
+#include <vector>
 
 namespace callx {
 
@@ -46,27 +48,88 @@ typedef std::deque<std::shared_ptr<MemChunk>> MemChunkDeque;
 class PcmAudio {
 public:
     PcmAudio(const std::string& callId,
-            const SipFromTo& caller,
-            const SipFromTo& callee,
+            const SipIdentity& caller,
+            const SipIdentity& callee,
             const systemClock::time_point& startTs,
             bool isCallerAudio);
     virtual ~PcmAudio();
 
     const std::string& getCallId() const;
-    const SipFromTo& getCaller() const;
-    const SipFromTo& getCallee() const;
+    const SipIdentity& getCaller() const;
+    const SipIdentity& getCallee() const;
     const systemClock::time_point& getStartTs() const;
     bool isCallerAudio() const;
 
+    /**
+     * Samples per second of the 16 bit PCM data, 8000 unless a wideband
+     * codec was decoded.
+     */
+    u_int getSampleRate() const;
+    void setSampleRate(u_int sampleRate);
+
+    /**
+     * Number of interleaved channels, 1 for the audio of one direction or 2
+     * for a call merged into stereo (left: caller, right: callee).
+     */
+    u_short getChannels() const;
+    void setChannels(u_short channels);
+
+    /**
+     * Codec of the data: ac_PCMA or ac_PCMU for G.711 bytes stored without
+     * decoding (wave_output_g711), ac_UNDEFINED for 16 bit PCM.
+     */
+    audioCodecEnum getEncoding() const;
+    void setEncoding(audioCodecEnum encoding);
+
     void addChunk(std::shared_ptr<MemChunk>& chunk);
+
+    /**
+     * Appends samples, filling the last MemChunk and continuing in new ones
+     * taken from the MemChunkPool.
+     * @param samples
+     * @param n Number of samples.
+     */
+    void append(const short* samples, size_t n);
+
+    /**
+     * Records a span of silence kept by the VoiceActivityDetector.
+     * @param start First sample (per channel).
+     * @param length Number of samples (per channel).
+     */
+    void addSilence(size_t start, size_t length);
+
+    /**
+     * Position after voicedSamples samples of voice, the kept silence is
+     * not counted.
+     * @param voicedSamples Number of samples (per channel).
+     * @return Number of samples (per channel) from the start.
+     */
+    size_t voicedEnd(size_t voicedSamples) const;
+
+    /**
+     * Appends one channel of the interleaved audio to a mono PcmAudio,
+     * together with the kept silence within the copied samples.
+     * @param channel 0 (caller) or 1 (callee).
+     * @param maxSamples Number of samples (per channel) to copy at most.
+     * @param pcmAudio Mono PcmAudio, empty.
+     */
+    void copyChannel(u_short channel, size_t maxSamples,
+            PcmAudio& pcmAudio) const;
+
     std::shared_ptr<MemChunkDeque> getChunkDeque();
 
 protected:
     std::string m_callId;
-    SipFromTo m_caller;
-    SipFromTo m_callee;
+    SipIdentity m_caller;
+    SipIdentity m_callee;
     systemClock::time_point m_startTs;
     bool m_isCallerAudio;
+    u_int m_sampleRate;
+    u_short m_channels;
+    audioCodecEnum m_encoding;
+
+    // kept silent spans (start, length), in order
+    std::vector<std::pair<size_t, size_t> > m_silence;
 
     std::shared_ptr<MemChunkDeque> m_memChunkDeque;
 };
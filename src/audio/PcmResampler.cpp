@@ -0,0 +1,259 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PcmResampler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "PcmResampler.hpp"
+#include "MemChunk.hpp"
+#include "main/callx.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RESAMPLER_X86_KERNELS
+#endif
+
+using namespace std;
+
+namespace callx {
+
+const double PcmResampler::Kaiser_Beta = 7.0;
+
+#ifdef RESAMPLER_X86_KERNELS
+
+// n is a multiple of Tap_Alignment
+
+__attribute__((target("sse")))
+static float dotSse(const float* a, const float* b, size_t n) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (size_t i = 0; i < n; i += 8) {
+        acc0 = _mm_add_ps(acc0,
+                _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1,
+                _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    float sum[4];
+    _mm_storeu_ps(sum, _mm_add_ps(acc0, acc1));
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+__attribute__((target("avx2,fma")))
+static float dotAvx2(const float* a, const float* b, size_t n) {
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t i = 0; i < n; i += 8) {
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i),
+                acc);
+    }
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(acc),
+            _mm256_extractf128_ps(acc, 1));
+    float sum[4];
+    _mm_storeu_ps(sum, sum4);
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+#endif
+
+// dot product kernel, selected once by the CPU features
+struct ResamplerKernel {
+    PcmResampler::DotKernel dot;
+    const char* name;
+};
+
+static const ResamplerKernel& resamplerKernel() {
+    static const ResamplerKernel kernel = []() {
+#ifdef RESAMPLER_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return ResamplerKernel { dotAvx2, "avx2" };
+        }
+        if (__builtin_cpu_supports("sse")) {
+            return ResamplerKernel { dotSse, "sse" };
+        }
+#endif
+        return ResamplerKernel { PcmResampler::dotScalar, "scalar" };
+    }();
+    return kernel;
+}
+
+// modified Bessel function of the first kind, order 0
+static double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50 && term > 1e-12 * sum; k++) {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+PcmResampler::PcmResampler(u_int outRate, u_int filterLength)
+        : m_outRate(outRate),
+          m_filterLength(filterLength),
+          m_dot(resamplerKernel().dot),
+          m_inputBase(0),
+          m_nextOutput(0) {
+}
+
+PcmResampler::~PcmResampler() {
+}
+
+const char* PcmResampler::kernelName() {
+    return resamplerKernel().name;
+}
+
+float PcmResampler::dotScalar(const float* a, const float* b, size_t n) {
+    float sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+const PcmResampler::Filter& PcmResampler::filter(u_int inRate) {
+    for (auto iter = m_filters.begin(); iter != m_filters.end(); iter++) {
+        if ((*iter)->inRate == inRate)
+            return **iter;
+    }
+
+    unique_ptr<Filter> filter(new Filter());
+    u_int a = inRate;
+    u_int b = m_outRate;
+    while (b) {
+        u_int r = a % b;
+        a = b;
+        b = r;
+    }
+    filter->inRate = inRate;
+    filter->up = m_outRate / a;
+    filter->down = inRate / a;
+    filter->taps = (m_filterLength + Tap_Alignment - 1) / Tap_Alignment
+            * Tap_Alignment;
+
+    // prototype low pass at the rate of inRate * up, cut off below the
+    // lower of both Nyquist frequencies; the center is rounded to a whole
+    // output sample, so the delay can be compensated exactly
+    size_t length = size_t(m_filterLength) * filter->up;
+    double cutoff = 0.45 / max(filter->up, filter->down);
+    filter->delay = size_t((length - 1) / 2.0 / filter->down + 0.5);
+    double center = double(filter->delay) * filter->down;
+    vector<double> prototype(length);
+    double sum = 0;
+    for (size_t n = 0; n < length; n++) {
+        double x = n - center;
+        double sinc = x == 0 ?
+                2 * cutoff : sin(2 * M_PI * cutoff * x) / (M_PI * x);
+        double r = 2.0 * n / (length - 1) - 1;
+        double window = besselI0(Kaiser_Beta * sqrt(max(0.0, 1 - r * r)))
+                / besselI0(Kaiser_Beta);
+        prototype[n] = sinc * window;
+        sum += prototype[n];
+    }
+
+    // split into the phases, newest sample last; the padding multiplies
+    // the oldest samples
+    filter->coeffs.assign(size_t(filter->up) * filter->taps, 0.0f);
+    for (u_int phase = 0; phase < filter->up; phase++) {
+        float* coeffs = &filter->coeffs[size_t(phase) * filter->taps];
+        for (u_int m = 0; m < m_filterLength; m++) {
+            coeffs[filter->taps - 1 - m] = float(
+                    prototype[phase + size_t(m) * filter->up] * filter->up
+                            / sum);
+        }
+    }
+
+    L_t
+    << "Resampling filter " << inRate << " Hz -> " << m_outRate << " Hz, up "
+    << filter->up << ", down " << filter->down << ", taps " << filter->taps;
+    m_filters.push_back(move(filter));
+    return *m_filters.back();
+}
+
+void PcmResampler::process(PcmAudio& pcmAudio) {
+    u_int inRate = pcmAudio.getSampleRate();
+    if (inRate == m_outRate || pcmAudio.getChannels() != 1) {
+        return;
+    }
+    const Filter& currFilter = filter(inRate);
+
+    // the converted audio replaces the input chunk by chunk
+    MemChunkDeque input;
+    input.swap(*pcmAudio.getChunkDeque());
+    size_t inSamples = 0;
+    for (auto iter = input.begin(); iter != input.end(); iter++) {
+        inSamples += (*iter)->fillingLevel() / sizeof(short);
+    }
+    size_t outputEnd = (uint64_t(inSamples) * currFilter.up
+            + currFilter.down / 2) / currFilter.down + currFilter.delay;
+    pcmAudio.setSampleRate(m_outRate);
+
+    m_input.assign(currFilter.taps - 1, 0.0f);
+    m_inputBase = 0;
+    m_nextOutput = 0;
+    while (!input.empty()) {
+        const short* samples =
+                reinterpret_cast<const short*>(input.front()->data());
+        size_t n = input.front()->fillingLevel() / sizeof(short);
+        m_input.insert(m_input.end(), samples, samples + n);
+        input.pop_front();
+
+        convert(currFilter, m_inputBase + n, outputEnd, pcmAudio);
+
+        // keep the history of the next chunk
+        m_input.erase(m_input.begin(), m_input.end() - (currFilter.taps - 1));
+        m_inputBase += n;
+    }
+
+    // the filter delay is flushed with silence
+    m_input.insert(m_input.end(), currFilter.taps + 1, 0.0f);
+    convert(currFilter, m_inputBase + currFilter.taps + 1, outputEnd,
+            pcmAudio);
+}
+
+void PcmResampler::convert(const Filter& filter, size_t inputEnd,
+        size_t outputEnd, PcmAudio& pcmAudio) {
+    m_output.clear();
+    for (; m_nextOutput < outputEnd; m_nextOutput++) {
+        uint64_t t = uint64_t(m_nextOutput) * filter.down;
+        size_t newest = t / filter.up;
+        if (newest >= inputEnd) {
+            break;
+        }
+        if (m_nextOutput < filter.delay) {
+            continue;
+        }
+        u_int phase = t % filter.up;
+        float sample = m_dot(&filter.coeffs[size_t(phase) * filter.taps],
+                &m_input[newest - m_inputBase], filter.taps);
+        m_output.push_back(
+                short(max(-32768.0f, min(32767.0f, nearbyintf(sample)))));
+    }
+    pcmAudio.append(m_output.data(), m_output.size());
+}
+
+} /* namespace callx */
@@ -0,0 +1,126 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PcmResampler.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef PCMRESAMPLER_HPP_
+#define PCMRESAMPLER_HPP_
+
+#include <memory>
+#include <vector>
+#include "main/CallxTypes.hpp"
+#include "PcmAudio.hpp"
+
+namespace callx {
+
+/**
+ * Converts decoded PcmAudio to a fixed output sample rate with a polyphase
+ * FIR filter (Kaiser windowed sinc). The rate ratio is reduced to up/down,
+ * every output sample is one dot product of filterLength taps of the phase
+ * it falls on. The dot product runs on AVX2/FMA or SSE if the CPU has it.
+ *
+ * The audio is converted MemChunk by MemChunk right after decoding, every
+ * converted chunk returns to the MemChunkPool at once. The filter delay is
+ * compensated, the output starts at the first input sample and has the
+ * length of the input.
+ *
+ * One object per thread, it keeps the filter state of the current audio.
+ */
+class PcmResampler {
+public:
+
+    // the taps of a phase are padded to a multiple of this
+    static const u_int Tap_Alignment = 8;
+
+    // Kaiser window parameter, about 70 dB stop band attenuation
+    static const double Kaiser_Beta;
+
+    /**
+     * @param outRate Sample rate of the output.
+     * @param filterLength Taps per polyphase branch.
+     */
+    PcmResampler(u_int outRate, u_int filterLength);
+    virtual ~PcmResampler();
+
+    /**
+     * Converts mono audio to the output rate, in place of its MemChunks.
+     * @param pcmAudio
+     */
+    void process(PcmAudio& pcmAudio);
+
+    /**
+     * Name of the dot product kernel in use, e.g. "avx2".
+     */
+    static const char* kernelName();
+
+    typedef float (*DotKernel)(const float* a, const float* b, size_t n);
+
+    static float dotScalar(const float* a, const float* b, size_t n);
+
+private:
+
+    // polyphase filter of one input rate
+    struct Filter {
+        u_int inRate;
+        u_int up;
+        u_int down;
+
+        // taps per phase, padded to Tap_Alignment
+        u_int taps;
+
+        // phase after phase, taps each, in reversed order
+        std::vector<float> coeffs;
+
+        // filter delay in output samples
+        size_t delay;
+    };
+
+    // filter of the input rate, designed on first use
+    const Filter& filter(u_int inRate);
+
+    // output samples j from m_nextOutput on, as far as the input reaches
+    void convert(const Filter& filter, size_t inputEnd, size_t outputEnd,
+            PcmAudio& pcmAudio);
+
+    u_int m_outRate;
+    u_int m_filterLength;
+    std::vector<std::unique_ptr<Filter> > m_filters;
+    DotKernel m_dot;
+
+    // input window: the history of taps - 1 samples and the current chunk,
+    // m_inputBase is the input index of its first sample
+    std::vector<float> m_input;
+    size_t m_inputBase;
+
+    // next output sample on the filter time line (delay included)
+    size_t m_nextOutput;
+    std::vector<short> m_output;
+};
+
+} /* namespace callx */
+
+#endif /* PCMRESAMPLER_HPP_ */
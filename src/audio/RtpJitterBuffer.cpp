@@ -0,0 +1,179 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpJitterBuffer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "RtpJitterBuffer.hpp"
+
+using namespace std;
+
+namespace callx {
+
+RtpJitterBuffer::RtpJitterBuffer()
+        : m_hasProbe(false),
+          m_started(false),
+          m_maxExtSeqNum(0),
+          m_nextExtSeqNum(0),
+          m_releasedMask(0) {
+}
+
+RtpJitterBuffer::~RtpJitterBuffer() {
+}
+
+void RtpJitterBuffer::push(const RtpPayload& rtpPayload) {
+    int64_t extSeqNum = extend(rtpPayload.seqNum);
+
+    if (!m_started) {
+        m_started = true;
+        extSeqNum = rtpPayload.seqNum;
+        m_maxExtSeqNum = extSeqNum;
+        m_nextExtSeqNum = extSeqNum;
+    } else if (extSeqNum > m_maxExtSeqNum + Max_Dropout
+            || extSeqNum < m_nextExtSeqNum - Max_Misorder) {
+        if (!m_hasProbe
+                || rtpPayload.seqNum != u_short(m_probe.header.seqNum + 1)) {
+
+            // A single packet far off may be garbage, wait for the next one.
+            if (m_hasProbe) {
+                m_stats.discarded++;
+            }
+            m_hasProbe = true;
+            m_probe.header = rtpPayload;
+            m_probe.payload.assign(rtpPayload.data,
+                    rtpPayload.data + rtpPayload.size);
+            m_probe.header.data = m_probe.payload.data();
+            return;
+        }
+
+        // Two packets in sequence: the sender restarted the stream. The
+        // new numbering continues behind the waiting packets.
+        m_hasProbe = false;
+        int64_t probeExtSeqNum = extendBehind(m_probe.header.seqNum);
+        insert(m_probe.header, probeExtSeqNum, true);
+        insert(rtpPayload, probeExtSeqNum + 1, false);
+        return;
+    } else if (extSeqNum < m_nextExtSeqNum) {
+        if (released(extSeqNum)) {
+            m_stats.duplicates++;
+        } else {
+            m_stats.late++;
+        }
+        return;
+    }
+    insert(rtpPayload, extSeqNum, false);
+}
+
+void RtpJitterBuffer::insert(const RtpPayload& rtpPayload, int64_t extSeqNum,
+        bool restart) {
+
+    // find the position, usually at the end
+    auto pos = m_entries.end();
+    while (pos != m_entries.begin() && (pos - 1)->extSeqNum >= extSeqNum) {
+        pos--;
+    }
+    if (pos != m_entries.end() && pos->extSeqNum == extSeqNum) {
+        m_stats.duplicates++;
+        return;
+    }
+
+    if (extSeqNum > m_maxExtSeqNum) {
+        m_maxExtSeqNum = extSeqNum;
+    } else if (extSeqNum < m_maxExtSeqNum) {
+        m_stats.reordered++;
+    }
+
+    Entry entry;
+    entry.extSeqNum = extSeqNum;
+    entry.restart = restart;
+    entry.header = rtpPayload;
+    if (!m_spare.empty()) {
+        entry.payload = move(m_spare.back());
+        m_spare.pop_back();
+    }
+    entry.payload.assign(rtpPayload.data, rtpPayload.data + rtpPayload.size);
+    m_entries.insert(pos, move(entry));
+}
+
+bool RtpJitterBuffer::pop(RtpPayload& rtpPayload, u_int& missing,
+        bool& restart, bool flush) {
+    if (m_entries.empty()) {
+        return false;
+    }
+
+    // Wait for a missing packet, unless it is Window_Size packets behind.
+    Entry& front = m_entries.front();
+    if (!flush && !front.restart && front.extSeqNum != m_nextExtSeqNum
+            && m_maxExtSeqNum - m_nextExtSeqNum < Window_Size) {
+        return false;
+    }
+
+    restart = front.restart;
+    missing = restart ? 0 : front.extSeqNum - m_nextExtSeqNum;
+    m_stats.lost += missing;
+
+    int64_t shift = front.extSeqNum + 1 - m_nextExtSeqNum;
+    m_releasedMask = (restart || shift >= 64) ? 0 : m_releasedMask << shift;
+    m_releasedMask |= 1;
+    m_nextExtSeqNum = front.extSeqNum + 1;
+
+    // keep the payload buffer of the previous packet for reuse
+    if (m_current.payload.capacity() && m_spare.size() < size_t(Window_Size)) {
+        m_spare.push_back(move(m_current.payload));
+    }
+    m_current = move(front);
+    m_entries.pop_front();
+
+    rtpPayload = m_current.header;
+    rtpPayload.data = m_current.payload.data();
+    rtpPayload.size = m_current.payload.size();
+    return true;
+}
+
+size_t RtpJitterBuffer::size() const {
+    return m_entries.size();
+}
+
+const RtpStreamStats& RtpJitterBuffer::stats() const {
+    return m_stats;
+}
+
+int64_t RtpJitterBuffer::extend(u_short seqNum) const {
+    int16_t delta = int16_t(seqNum - u_short(m_maxExtSeqNum));
+    return m_maxExtSeqNum + delta;
+}
+
+int64_t RtpJitterBuffer::extendBehind(u_short seqNum) const {
+    u_short delta = seqNum - u_short(m_maxExtSeqNum + 1);
+    return m_maxExtSeqNum + 1 + delta;
+}
+
+bool RtpJitterBuffer::released(int64_t extSeqNum) const {
+    int64_t age = m_nextExtSeqNum - 1 - extSeqNum;
+    return age < 64 && (m_releasedMask >> age) & 1;
+}
+
+} /* namespace callx */
@@ -0,0 +1,181 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpJitterBuffer.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef RTPJITTERBUFFER_HPP_
+#define RTPJITTERBUFFER_HPP_
+
+#include <deque>
+#include <vector>
+#include <stdint.h>
+#include "RtpPayload.hpp"
+
+namespace callx {
+
+/**
+ * Packet loss and ordering counters of one RTP stream.
+ */
+struct RtpStreamStats {
+    // sequence numbers never received (in time)
+    u_int lost;
+
+    // packets received after a packet with a higher sequence number
+    u_int reordered;
+
+    // packets received twice
+    u_int duplicates;
+
+    // packets received after their sequence number was given up
+    u_int late;
+
+    // switches of the decoded source (SSRC)
+    u_int ssrcChanges;
+
+    // packets which were not decoded: of other sources (SSRC) or a single
+    // packet far off the sequence numbers
+    u_int discarded;
+
+    RtpStreamStats()
+            : lost(0),
+              reordered(0),
+              duplicates(0),
+              late(0),
+              ssrcChanges(0),
+              discarded(0) {
+    }
+
+    RtpStreamStats& operator+=(const RtpStreamStats& other) {
+        lost += other.lost;
+        reordered += other.reordered;
+        duplicates += other.duplicates;
+        late += other.late;
+        ssrcChanges += other.ssrcChanges;
+        discarded += other.discarded;
+        return *this;
+    }
+};
+
+/**
+ * Reorder stage of one RTP stream. Packets are sorted by their extended
+ * (wraparound free) sequence number and leave the buffer in order: at once
+ * if there is no gap, otherwise when the gap is older than Window_Size
+ * packets. Duplicates and packets arriving too late are dropped. The
+ * payloads are copied, the source packet may be recycled after push().
+ *
+ * A sequence number jump beyond Max_Dropout / Max_Misorder is taken as a
+ * restart of the sender once the next packet confirms it (probation, RFC
+ * 3550 A.1). The numbering continues behind the waiting packets and the
+ * first packet of the new sequence is marked as restart.
+ */
+class RtpJitterBuffer {
+public:
+
+    // packets waited for a missing sequence number
+    static const int64_t Window_Size = 32;
+
+    // larger sequence number jumps restart the stream (RFC 3550, A.1)
+    static const int64_t Max_Dropout = 3000;
+    static const int64_t Max_Misorder = 100;
+
+    RtpJitterBuffer();
+    virtual ~RtpJitterBuffer();
+
+    /**
+     * Inserts a packet.
+     * @param rtpPayload
+     */
+    void push(const RtpPayload& rtpPayload);
+
+    /**
+     * Takes the next packet in sequence order.
+     * @param rtpPayload Set to the packet, valid until the next call.
+     * @param missing Set to the number of sequence numbers lost before it.
+     * @param restart Set to true, if the stream restarted with this packet,
+     * i.e. the timestamps are not continuous.
+     * @param flush Take the packets waiting for a gap as well.
+     * @return False, if no packet is ready.
+     */
+    bool pop(RtpPayload& rtpPayload, u_int& missing, bool& restart,
+            bool flush);
+
+    /**
+     * Number of waiting packets.
+     */
+    size_t size() const;
+
+    const RtpStreamStats& stats() const;
+
+private:
+
+    struct Entry {
+        int64_t extSeqNum;
+        bool restart;
+        RtpPayload header;
+        std::vector<u_char> payload;
+    };
+
+    // extended sequence number of seqNum, the closest to m_maxExtSeqNum
+    int64_t extend(u_short seqNum) const;
+
+    // the first extended sequence number of seqNum behind the waiting
+    // packets, the numbering of a restarted sequence
+    int64_t extendBehind(u_short seqNum) const;
+
+    // inserts a packet in sequence number order
+    void insert(const RtpPayload& rtpPayload, int64_t extSeqNum,
+            bool restart);
+
+    // Is extSeqNum one of the 64 packets released last?
+    bool released(int64_t extSeqNum) const;
+
+    // waiting packets, ascending extended sequence numbers
+    std::deque<Entry> m_entries;
+
+    // the packet returned last and the payload buffers for reuse
+    Entry m_current;
+
+    // packet of a sequence number jump, waiting for the next one to confirm
+    // the restart
+    bool m_hasProbe;
+    Entry m_probe;
+
+    std::vector<std::vector<u_char> > m_spare;
+
+    bool m_started;
+    int64_t m_maxExtSeqNum;
+    int64_t m_nextExtSeqNum;
+
+    // bit i: m_nextExtSeqNum - 1 - i has been released
+    uint64_t m_releasedMask;
+
+    RtpStreamStats m_stats;
+};
+
+} /* namespace callx */
+
+#endif /* RTPJITTERBUFFER_HPP_ */
@@ -0,0 +1,89 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpPayload.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef RTPPAYLOAD_HPP_
+#define RTPPAYLOAD_HPP_
+
+#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace callx {
+
+/**
+ * The RTP header fields needed for decoding and a pointer to the payload.
+ */
+struct RtpPayload {
+    u_short seqNum;
+    uint32_t timestamp;
+    uint32_t ssrc;
+    u_char payloadType;
+    const u_char* data;
+    size_t size;
+
+    /**
+     * Parses an RTP packet (RFC 3550). CSRC list, header extension and
+     * padding are skipped.
+     * @param packet
+     * @param packetSize
+     * @return False, if the packet is malformed.
+     */
+    bool parse(const u_char* packet, size_t packetSize) {
+        if (packetSize < 12 || packet[0] >> 6 != 2)
+            return false;
+
+        size_t headerSize = 12 + 4 * (packet[0] & 0x0F);
+        if (packet[0] & 0x10) {
+            if (packetSize < headerSize + 4)
+                return false;
+            headerSize += 4
+                    + 4 * ((packet[headerSize + 2] << 8)
+                            | packet[headerSize + 3]);
+        }
+        size_t paddingSize = 0;
+        if (packet[0] & 0x20)
+            paddingSize = packet[packetSize - 1];
+        if (packetSize < headerSize + paddingSize)
+            return false;
+
+        payloadType = packet[1] & 0x7F; // without marker-bit
+        seqNum = (packet[2] << 8) | packet[3];
+        timestamp = (uint32_t(packet[4]) << 24) | (packet[5] << 16)
+                | (packet[6] << 8) | packet[7];
+        ssrc = (uint32_t(packet[8]) << 24) | (packet[9] << 16)
+                | (packet[10] << 8) | packet[11];
+        data = packet + headerSize;
+        size = packetSize - headerSize - paddingSize;
+        return true;
+    }
+};
+
+} /* namespace callx */
+
+#endif /* RTPPAYLOAD_HPP_ */
@@ -0,0 +1,121 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpPayloadStore.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "RtpPayloadStore.hpp"
+#include "main/callx.hpp"
+#include <string.h>
+#include <algorithm>
+
+using namespace std;
+
+namespace callx {
+
+RtpPayloadStore::RtpPayloadStore()
+        : m_size(0),
+          m_bytes(0),
+          m_dropped(0) {
+}
+
+RtpPayloadStore::~RtpPayloadStore() {
+}
+
+void RtpPayloadStore::append(const RtpPayload& rtpPayload) {
+    // Record::size holds the payload size
+    if (rtpPayload.size > 0xFFFF) {
+        m_dropped++;
+        L_w
+        << "RTP payload of " << rtpPayload.size << " bytes not stored, "
+        << m_dropped << " dropped so far.";
+        return;
+    }
+    size_t size = recordSize(rtpPayload.size);
+
+    // start a new chunk, twice the size of the last one, if the record
+    // does not fit
+    if (m_chunks.empty()
+            || m_chunks.back().used + size > m_chunks.back().capacity) {
+        size_t capacity = m_chunks.empty() ?
+                First_Chunk_Size :
+                min(m_chunks.back().capacity * 2, size_t(Chunk_Size));
+        capacity = max(capacity, size);
+        Chunk chunk = { unique_ptr<u_char[]>(new u_char[capacity]), capacity,
+                0 };
+        m_chunks.push_back(move(chunk));
+        m_bytes += capacity;
+    }
+
+    Chunk& chunk = m_chunks.back();
+    u_char* dest = chunk.data.get() + chunk.used;
+    Record* record = reinterpret_cast<Record*>(dest);
+    record->timestamp = rtpPayload.timestamp;
+    record->ssrc = rtpPayload.ssrc;
+    record->seqNum = rtpPayload.seqNum;
+    record->size = rtpPayload.size;
+    record->payloadType = rtpPayload.payloadType;
+    memcpy(dest + sizeof(Record), rtpPayload.data, rtpPayload.size);
+
+    chunk.used += size;
+    m_size++;
+}
+
+size_t RtpPayloadStore::size() const {
+    return m_size;
+}
+
+size_t RtpPayloadStore::bytes() const {
+    return m_bytes;
+}
+
+size_t RtpPayloadStore::dropped() const {
+    return m_dropped;
+}
+
+bool RtpPayloadStore::Reader::next(RtpPayload& rtpPayload) {
+    while (m_chunk < m_store.m_chunks.size()
+            && m_offset >= m_store.m_chunks[m_chunk].used) {
+        m_chunk++;
+        m_offset = 0;
+    }
+    if (m_chunk >= m_store.m_chunks.size())
+        return false;
+
+    const u_char* src = m_store.m_chunks[m_chunk].data.get() + m_offset;
+    const Record* record = reinterpret_cast<const Record*>(src);
+    rtpPayload.timestamp = record->timestamp;
+    rtpPayload.ssrc = record->ssrc;
+    rtpPayload.seqNum = record->seqNum;
+    rtpPayload.payloadType = record->payloadType;
+    rtpPayload.data = src + sizeof(Record);
+    rtpPayload.size = record->size;
+
+    m_offset += recordSize(record->size);
+    return true;
+}
+
+} /* namespace callx */
@@ -0,0 +1,131 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpPayloadStore.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef RTPPAYLOADSTORE_HPP_
+#define RTPPAYLOADSTORE_HPP_
+
+#include <memory>
+#include <vector>
+#include "RtpPayload.hpp"
+
+namespace callx {
+
+/**
+ * Append-only store of the RTP payloads of one media stream. Only the
+ * header fields needed for decoding and the payload are copied into a list
+ * of chunks, so the TlayerPacket can be recycled on arrival. The chunks
+ * grow geometrically from First_Chunk_Size to Chunk_Size, so short or
+ * one-sided streams only take a few KiB.
+ */
+class RtpPayloadStore {
+public:
+
+    // size of the first and maximum size of the later chunks, a larger
+    // record gets a chunk of its own size
+    static const size_t First_Chunk_Size = 1 << 12;
+    static const size_t Chunk_Size = 1 << 16;
+
+    /**
+     * Sequential reader of the stored payloads.
+     */
+    class Reader {
+    public:
+        Reader(const RtpPayloadStore& store)
+                : m_store(store),
+                  m_chunk(0),
+                  m_offset(0) {
+        }
+
+        /**
+         * @param rtpPayload Set to the next payload, valid as long as the
+         * store exists.
+         * @return False, if there are no more payloads.
+         */
+        bool next(RtpPayload& rtpPayload);
+
+    private:
+        const RtpPayloadStore& m_store;
+        size_t m_chunk;
+        size_t m_offset;
+    };
+
+    RtpPayloadStore();
+    virtual ~RtpPayloadStore();
+
+    /**
+     * Appends a payload.
+     * @param rtpPayload
+     */
+    void append(const RtpPayload& rtpPayload);
+
+    /**
+     * Number of stored payloads.
+     */
+    size_t size() const;
+
+    /**
+     * Allocated memory in bytes.
+     */
+    size_t bytes() const;
+
+    /**
+     * Number of payloads not stored, their size does not fit a record.
+     */
+    size_t dropped() const;
+
+private:
+
+    // stored header fields, followed by the payload (4 byte aligned)
+    struct Record {
+        uint32_t timestamp;
+        uint32_t ssrc;
+        u_short seqNum;
+        u_short size;
+        u_char payloadType;
+    };
+
+    static size_t recordSize(size_t payloadSize) {
+        return (sizeof(Record) + payloadSize + 3) & ~size_t(3);
+    }
+
+    struct Chunk {
+        std::unique_ptr<u_char[]> data;
+        size_t capacity;
+        size_t used;
+    };
+
+    std::vector<Chunk> m_chunks;
+    size_t m_size;
+    size_t m_bytes;
+    size_t m_dropped;
+};
+
+} /* namespace callx */
+
+#endif /* RTPPAYLOADSTORE_HPP_ */
@@ -31,20 +31,37 @@
 #include "RtpSink.hpp"
 #include "network/TlayerPacket.hpp"
 #include "network/TlayerPacketRecycler.hpp"
+#include "container/TimeoutWheel.hpp"
+#include "config/CallxConfig.hpp"
+#include "RtpStreamDecoder.hpp"
+#include "RtpPayloadStore.hpp"
 
 using namespace std;
 
 namespace callx {
 
-RtpSink::RtpSink(bool isCallerSink)
+RtpSink::RtpSink(bool isCallerSink, const PayloadTypeMap& payloadTypeMap,
+        u_int ptime)
         : m_isCallerSink(isCallerSink),
+          m_payloadTypeMap(payloadTypeMap),
+          m_ptime(ptime),
           m_active(true),
-          m_activityTs(steadyClock::now()),
+          m_captured(0),
+          m_hasFirstPacket(false),
+          m_firstSsrc(0),
+          m_firstTimestamp(0),
           m_rtpSinkStatus(rs_INIT),
-          m_rtpPacketDeque(unique_ptr<TlayerDeque>(new TlayerDeque())),
-          m_packetCount(0),
-          m_packetCountOld(0),
-          m_tlayerPacketQueue(TlayerPacketQueue::getInstance()) {
+          m_rtpPayloadStore(unique_ptr<RtpPayloadStore>(new RtpPayloadStore())),
+          m_tlayerPacketQueue(TlayerPacketQueue::getInstance()),
+          m_timeoutWheel(TimeoutWheel::getInstance()) {
+    m_lastPacketTick = m_timeoutWheel->currentTick();
+    CallxConfig* callxConfig = CallxConfig::getInstance();
+    m_captureBudget = callxConfig->capture_budget_seconds * Rtp_Clock_Rate;
+    m_streaming = callxConfig->rtp_streaming_decode;
+    if (m_streaming) {
+        m_streamDecoder.reset(
+                new RtpStreamDecoder(callxConfig->wave_output_g711));
+    }
     L_t
     << "C'tor";
 }
@@ -55,38 +72,78 @@ RtpSink::~RtpSink() {
 }
 
 void RtpSink::rollIn(std::unique_ptr<TlayerPacket, TlayerPacketRecycler>&& tlayerPacket) {
-    if(m_active) {
-        // Save the  RTP packet.
-        m_rtpPacketDeque->push_back(forward<std::unique_ptr<TlayerPacket,
-                TlayerPacketRecycler>>(tlayerPacket));
-    } else {
-        // RtpSink is not activated. The recording time may be exceeded.
-        // Push TlayerPacket back to the TlayerPacketQueue. Is this a bit
-        // faster than relying on the TlayerPacketRecycler?
-        m_tlayerPacketQueue->push(forward<std::unique_ptr<TlayerPacket,
-                TlayerPacketRecycler>>(tlayerPacket));
+    RtpPayload rtpPayload;
+    if (m_active
+            && rtpPayload.parse(tlayerPacket->m_udpPacket.payload,
+                    tlayerPacket->m_udpPacket.payloadLen)) {
+        lock_guard lock(m_mutex);
+        if (!m_hasFirstPacket) {
+            const timeval& ts = tlayerPacket->m_pcapPacket.header.ts;
+            m_firstPacketTs = systemClock::time_point(
+                    boost::chrono::duration_cast<systemClock::duration>(
+                            boost::chrono::seconds(ts.tv_sec)
+                                    + boost::chrono::microseconds(
+                                            ts.tv_usec)));
+            m_firstSsrc = rtpPayload.ssrc;
+            m_firstTimestamp = rtpPayload.timestamp;
+            m_hasFirstPacket = true;
+        }
+        if (m_streaming) {
+            // Streaming mode: decode now.
+            if (m_streamDecoder)
+                m_streamDecoder->decode(m_payloadTypeMap, rtpPayload);
+        } else if (m_rtpPayloadStore) {
+            // Save the RTP payload.
+            m_rtpPayloadStore->append(rtpPayload);
+        }
+
+        // Stop capturing, if the outputs will not use more audio.
+        size_t captured = m_captured.load(memory_order_relaxed)
+                + audioCodecDuration(
+                        m_payloadTypeMap.getCodec(rtpPayload.payloadType),
+                        rtpPayload.size);
+        m_captured.store(captured, memory_order_relaxed);
+        if (m_captureBudget && captured >= m_captureBudget) {
+            m_active = false;
+        }
     }
-    m_packetCount++;
+
+    // Push TlayerPacket back to the TlayerPacketQueue. Is this a bit
+    // faster than relying on the TlayerPacketRecycler?
+    m_tlayerPacketQueue->push(forward<std::unique_ptr<TlayerPacket,
+            TlayerPacketRecycler>>(tlayerPacket));
+
+    // A relaxed store of the coarse clock is all the per packet cost of the
+    // activity check.
+    m_lastPacketTick.store(m_timeoutWheel->currentTick(),
+            memory_order_relaxed);
 }
 
-size_t RtpSink::inactiveFor() {
-    if (m_packetCount > m_packetCountOld) {
-        m_packetCount = m_packetCountOld;
-        m_activityTs = steadyClock::now();
+size_t RtpSink::inactiveFor() const {
+    uint64_t now = m_timeoutWheel->currentTick();
+    uint64_t last = m_lastPacketTick.load(memory_order_relaxed);
+    if (last >= now) {
         return 0;
-    } else {
-        return (boost::chrono::duration_cast<seconds>(
-                steadyClock::now() - m_activityTs)).count();
     }
-
+    return (now - last) * TimeoutWheel::Tick_Milliseconds / 1000;
 }
 
 void RtpSink::deactivate() {
     m_active = false;
 }
 
-unique_ptr<TlayerDeque> RtpSink::getTlayerDeque() {
-    return move(m_rtpPacketDeque);
+size_t RtpSink::capturedSeconds() const {
+    return m_captured.load(memory_order_relaxed) / Rtp_Clock_Rate;
+}
+
+unique_ptr<RtpPayloadStore> RtpSink::getPayloadStore() {
+    lock_guard lock(m_mutex);
+    return move(m_rtpPayloadStore);
+}
+
+unique_ptr<RtpStreamDecoder> RtpSink::getStreamDecoder() {
+    lock_guard lock(m_mutex);
+    return move(m_streamDecoder);
 }
 
 rtpSinkStatusEnum RtpSink::getStatus() const {
@@ -101,4 +158,38 @@ bool RtpSink::isCallerSink() const {
     return m_isCallerSink;
 }
 
+void RtpSink::setMediaFormat(const PayloadTypeMap& payloadTypeMap,
+        u_int ptime) {
+    lock_guard lock(m_mutex);
+    m_payloadTypeMap = payloadTypeMap;
+    m_ptime = ptime;
+}
+
+PayloadTypeMap RtpSink::getPayloadTypeMap() const {
+    lock_guard lock(m_mutex);
+    return m_payloadTypeMap;
+}
+
+u_int RtpSink::getPtime() const {
+    lock_guard lock(m_mutex);
+    return m_ptime;
+}
+
+systemClock::time_point RtpSink::getAudioStartTs(
+        const RtpStreamDecoder& streamDecoder) const {
+    lock_guard lock(m_mutex);
+    uint32_t ssrc;
+    uint32_t timestamp;
+    if (!streamDecoder.firstTimestamp(ssrc, timestamp) || ssrc != m_firstSsrc) {
+        return m_firstPacketTs;
+    }
+
+    // signed difference, the first decoded packet may have arrived later
+    int32_t ticks = int32_t(timestamp - m_firstTimestamp);
+    return m_firstPacketTs
+            + boost::chrono::duration_cast<systemClock::duration>(
+                    boost::chrono::microseconds(
+                            int64_t(ticks) * 1000000 / Rtp_Clock_Rate));
+}
+
 } /* namespace callx */
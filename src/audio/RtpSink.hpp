@@ -34,13 +34,18 @@
 #include <queue>
 #include <string>
 #include <memory>
+#include <atomic>
 #include "main/CallxTypes.hpp"
+#include "audio.hpp"
 
 namespace callx {
 
 class TlayerPacket;
 class TlayerPacketRecycler;
 class TlayerPacketQueue;
+class TimeoutWheel;
+class RtpStreamDecoder;
+class RtpPayloadStore;
 
 enum rtpSinkStatusEnum {
     rs_INIT = 0,
@@ -58,20 +63,25 @@ inline std::string rtpSinkStatusEnumToString(rtpSinkStatusEnum status) {
 
 class RtpSink {
 public:
-    RtpSink(bool isCallerSink);
+    RtpSink(bool isCallerSink, const PayloadTypeMap& payloadTypeMap,
+            u_int ptime);
     virtual ~RtpSink();
 
     /**
-     * Stores a TlayerPacket with RTP data in an internal queue.
+     * Copies the RTP payload of a TlayerPacket into the internal payload
+     * store, in streaming mode (rtp_streaming_decode) the payload is
+     * decoded instead. The TlayerPacket is recycled at once. The sink
+     * deactivates itself, when capture_budget_seconds of audio have been
+     * captured.
      * @param tlayerPacket
      */
     void rollIn(std::unique_ptr<TlayerPacket, TlayerPacketRecycler>&& tlayerPacket);
 
     /**
-     * Returns RtpSink inactivity time.
+     * Returns RtpSink inactivity time, measured in TimeoutWheel ticks.
      * @return Number of seconds of inactivity.
      */
-    size_t inactiveFor();
+    size_t inactiveFor() const;
 
     /**
      * Deactivates the storing of TlaerPacket objects.
@@ -79,11 +89,24 @@ public:
     void deactivate();
 
     /**
-     * Transafers the internal queue of TlayerPacket objects (unique_ptr).
-     * After that, the RtpSink is no longer the owner of the queue.
-     * @return unique_ptr of the internal TlayerDeque.
+     * Seconds of audio captured so far, measured by the RTP payload sizes.
+     * @return Number of seconds.
      */
-    std::unique_ptr<TlayerDeque> getTlayerDeque();
+    size_t capturedSeconds() const;
+
+    /**
+     * Transfers the internal payload store. After that, the RtpSink is no
+     * longer the owner of the store.
+     * @return unique_ptr of the internal RtpPayloadStore.
+     */
+    std::unique_ptr<RtpPayloadStore> getPayloadStore();
+
+    /**
+     * Transfers the stream decoder holding the audio decoded so far and
+     * stops the decoding of further packets.
+     * @return The stream decoder, NULL if not in streaming mode.
+     */
+    std::unique_ptr<RtpStreamDecoder> getStreamDecoder();
     void setStatus(rtpSinkStatusEnum status);
     rtpSinkStatusEnum getStatus() const;
 
@@ -93,29 +116,77 @@ public:
      */
     bool isCallerSink() const;
 
+    /**
+     * Sets the payload type mapping and packetization time of the media
+     * stream, e.g. after a re-INVITE.
+     */
+    void setMediaFormat(const PayloadTypeMap& payloadTypeMap, u_int ptime);
+
+    /**
+     * RTP payload type to codec mapping of the media stream (SDP).
+     * @return A copy, the mapping may change while the call is active.
+     */
+    PayloadTypeMap getPayloadTypeMap() const;
+
+    /**
+     * Packetization time in milliseconds (SDP), 0 if not signaled.
+     */
+    u_int getPtime() const;
+
+    /**
+     * Arrival time of the audio decoded by streamDecoder, the capture time
+     * of the first RTP packet moved by the RTP timestamp difference to the
+     * first decoded packet.
+     * @param streamDecoder Decoder of the packets of this sink.
+     * @return Start of the audio, the capture time of the first packet if
+     * the decoder started with another source.
+     */
+    systemClock::time_point getAudioStartTs(
+            const RtpStreamDecoder& streamDecoder) const;
+
 protected:
 
     // caller or callee sink
     bool m_isCallerSink;
 
+    // payload type mapping and packetization time of the media stream,
+    // guarded by m_mutex (a re-INVITE may change them)
+    PayloadTypeMap m_payloadTypeMap;
+    u_int m_ptime;
+
     // If RTP data should be stored or discarded.
-    bool m_active;
+    std::atomic<bool> m_active;
+
+    // audio captured and capture budget (0: unlimited) in RTP clock ticks
+    std::atomic<size_t> m_captured;
+    size_t m_captureBudget;
 
-    // activity timestamp (steady clock)
-    steadyClock::time_point m_activityTs;
+    // capture time, SSRC and RTP timestamp of the first packet, guarded by
+    // m_mutex
+    bool m_hasFirstPacket;
+    systemClock::time_point m_firstPacketTs;
+    uint32_t m_firstSsrc;
+    uint32_t m_firstTimestamp;
+
+    // TimeoutWheel tick of the last RTP packet (or of the creation)
+    std::atomic<uint64_t> m_lastPacketTick;
 
     // status of the RTP sink
     rtpSinkStatusEnum m_rtpSinkStatus;
 
-    // stored RTP data
-    std::unique_ptr<TlayerDeque> m_rtpPacketDeque;
+    // stored RTP payloads, guarded by m_mutex
+    std::unique_ptr<RtpPayloadStore> m_rtpPayloadStore;
 
-    // packet count (for activity check)
-    size_t m_packetCount;
-    size_t m_packetCountOld;
+    // decoder in streaming mode, guarded by m_mutex
+    bool m_streaming;
+    std::unique_ptr<RtpStreamDecoder> m_streamDecoder;
+    mutable mutex m_mutex;
 
     // For the manual (faster?) recycling of TlayerPackets.
     TlayerPacketQueue* m_tlayerPacketQueue;
+
+    // coarse clock for the activity check
+    TimeoutWheel* m_timeoutWheel;
 };
 
 } /* namespace callx */
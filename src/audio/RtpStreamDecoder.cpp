@@ -0,0 +1,487 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpStreamDecoder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "RtpStreamDecoder.hpp"
+#include "main/callx.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace callx {
+
+RtpStreamDecoder::RtpStreamDecoder(bool keepG711)
+        : m_memChunkPool(MemChunkPool::getInstance()),
+          m_decoderFactory(AudioDecoderFactory::getInstance()),
+          m_activeSource(NULL),
+          m_sourceSwitched(false),
+          m_packets(0),
+          m_seqNumErrors(0),
+          m_hasTimestamp(false),
+          m_nextTimestamp(0),
+          m_lastDuration(0),
+          m_sampleRate(0),
+          m_keepG711(keepG711),
+          m_encoding(ac_UNDEFINED),
+          m_firstSsrc(0),
+          m_firstTimestamp(0),
+          m_lastSample(0),
+          m_concealedFrames(0) {
+}
+
+RtpStreamDecoder::~RtpStreamDecoder() {
+}
+
+void RtpStreamDecoder::decode(const PayloadTypeMap& payloadTypeMap,
+        const RtpPayload& rtpPayload) {
+    Source& currSource = source(rtpPayload.ssrc);
+    currSource.jitterBuffer.push(rtpPayload);
+    currSource.lastPacket = ++m_packets;
+
+    if (!m_activeSource) {
+        m_activeSource = &currSource;
+    }
+
+    if (&currSource == m_activeSource) {
+
+        // The other sources have to start over.
+        for (auto iter = m_sources.begin(); iter != m_sources.end(); iter++) {
+            (*iter)->packetsInRow = 0;
+        }
+    } else if (++currSource.packetsInRow >= Switch_Packets) {
+
+        // Another source took over, finish the current one.
+        L_t
+        << "SSRC change from " << m_activeSource->ssrc
+        << " to " << currSource.ssrc;
+        decodeActive(payloadTypeMap, true);
+        for (int codec = 0; codec <= ac_TELEPHONE_EVENT; codec++) {
+            if (m_decoders[codec])
+                m_decoders[codec]->reset();
+        }
+        m_activeSource = &currSource;
+        m_sourceSwitched = true;
+        m_stats.ssrcChanges++;
+    } else {
+
+        // Keep the packets which may start a takeover only.
+        RtpPayload discardedPayload;
+        u_int missing;
+        bool restart;
+        while (currSource.jitterBuffer.size() > Switch_Packets
+                && currSource.jitterBuffer.pop(discardedPayload, missing,
+                        restart, true)) {
+            m_stats.discarded++;
+        }
+        return;
+    }
+
+    decodeActive(payloadTypeMap, false);
+}
+
+void RtpStreamDecoder::flush(const PayloadTypeMap& payloadTypeMap) {
+    if (m_activeSource) {
+        decodeActive(payloadTypeMap, true);
+    }
+}
+
+void RtpStreamDecoder::decodeActive(const PayloadTypeMap& payloadTypeMap,
+        bool flush) {
+    RtpPayload orderedPayload;
+    u_int missing;
+    bool restart;
+    while (m_activeSource->jitterBuffer.pop(orderedPayload, missing, restart,
+            flush)) {
+
+        // The timestamps of a new source do not continue the previous ones.
+        decodeInOrder(payloadTypeMap, orderedPayload, missing,
+                restart || m_sourceSwitched);
+        m_sourceSwitched = false;
+    }
+}
+
+RtpStreamDecoder::Source& RtpStreamDecoder::source(uint32_t ssrc) {
+    for (auto iter = m_sources.begin(); iter != m_sources.end(); iter++) {
+        if ((*iter)->ssrc == ssrc) {
+            return **iter;
+        }
+    }
+
+    unique_ptr<Source> newSource(new Source());
+    newSource->ssrc = ssrc;
+    newSource->packetsInRow = 0;
+    newSource->lastPacket = 0;
+
+    if (m_sources.size() < Max_Sources) {
+        m_sources.push_back(move(newSource));
+        return *m_sources.back();
+    }
+
+    // replace the least recent source which is not decoded
+    auto leastRecent = m_sources.end();
+    for (auto iter = m_sources.begin(); iter != m_sources.end(); iter++) {
+        if (iter->get() != m_activeSource
+                && (leastRecent == m_sources.end()
+                        || (*iter)->lastPacket < (*leastRecent)->lastPacket)) {
+            leastRecent = iter;
+        }
+    }
+    m_stats.discarded += (*leastRecent)->jitterBuffer.size();
+    m_stats += (*leastRecent)->jitterBuffer.stats();
+    *leastRecent = move(newSource);
+    return **leastRecent;
+}
+
+void RtpStreamDecoder::decodeInOrder(const PayloadTypeMap& payloadTypeMap,
+        const RtpPayload& rtpPayload, u_int missing, bool restart) {
+    u_char rtpPayloadType = rtpPayload.payloadType;
+
+    if (missing) {
+        m_seqNumErrors++;
+        L_t
+        << "seq num error, missing "
+        << missing
+        << " before rtpSeqNum="
+        << rtpPayload.seqNum;
+    }
+
+    // codec of the payload type as negotiated in SDP
+    audioCodecEnum codec = payloadTypeMap.getCodec(rtpPayloadType);
+    AudioDecoderInterface* audioDecoder = decoder(codec);
+    if (!audioDecoder) {
+        L_t
+        << "RTP payloadtype not supported: " << (u_int) rtpPayloadType
+        << " (" << audioCodecEnumToString(codec) << ")";
+        return;
+    }
+
+    // Only one law is stored undecoded, any other codec needs PCM.
+    if (m_encoding != ac_UNDEFINED && codec != m_encoding) {
+        L_t
+        << "Codec change to " << audioCodecEnumToString(codec)
+        << ", decoding the stored " << audioCodecEnumToString(m_encoding);
+        expand();
+    }
+
+    // RTP payload has to be greater than or equal to the decoder input
+    // buffer size.
+    size_t frames = rtpPayload.size / audioDecoder->inBufSize;
+    if (!frames) {
+        L_e
+        << "RTP payload smaller than decoder input buffer.";
+        return;
+    }
+
+    // Fill the time between the expected and the actual timestamp. If the
+    // timestamps do not tell, the lost packets are assumed to be as long
+    // as the last one. A gap without loss is a pause of the sender (silence
+    // suppression) and filled with silence only.
+    if (m_hasTimestamp && !restart) {
+        if (!missing) {
+            m_concealedFrames = Plc_Frames;
+        }
+        int32_t gap = int32_t(rtpPayload.timestamp - m_nextTimestamp);
+        if (gap <= 0 && missing) {
+            gap = missing * m_lastDuration;
+        }
+        if (gap > 0 && size_t(gap) <= Max_Gap_Ticks) {
+            conceal(gap);
+        }
+    }
+
+    // The stream keeps the sample rate of its first audio.
+    if (!m_sampleRate) {
+        m_sampleRate = audioDecoder->sampleRate;
+        m_firstSsrc = rtpPayload.ssrc;
+        m_firstTimestamp = rtpPayload.timestamp;
+        if (m_keepG711 && (codec == ac_PCMA || codec == ac_PCMU)) {
+            m_encoding = codec;
+        }
+    }
+
+    size_t frameSamples = audioDecoder->outBufSize / sizeof(short);
+
+    // G.711 and G.722 frames are single bytes, the concealment repeats at
+    // least 10 ms though
+    size_t plcSamples = max(frameSamples, size_t(m_sampleRate / 100));
+    if (m_encoding != ac_UNDEFINED) {
+
+        // G.711 is stored as it is, one byte per sample
+        writeEncoded(rtpPayload.data, frames * audioDecoder->inBufSize);
+    } else if (audioDecoder->sampleRate == m_sampleRate) {
+
+        // decode the frames in batches straight into the MemChunks, a
+        // frame crossing the end of a MemChunk is copied
+        size_t frame = 0;
+        while (frame < frames) {
+            short* buffer;
+            size_t batch = declare((frames - frame) * frameSamples, &buffer)
+                    / frameSamples;
+            const u_char* in = rtpPayload.data
+                    + frame * audioDecoder->inBufSize;
+            if (batch) {
+                audioDecoder->decode(in, batch * audioDecoder->inBufSize,
+                        buffer);
+                commit(batch * frameSamples);
+            } else {
+                batch = 1;
+                m_decodeBuffer.resize(frameSamples);
+                buffer = m_decodeBuffer.data();
+                audioDecoder->decode(in, audioDecoder->inBufSize, buffer);
+                write(buffer, frameSamples);
+            }
+            keepLastFrame(buffer, batch * frameSamples, plcSamples);
+            frame += batch;
+        }
+    } else {
+
+        // codec change to another sample rate, e.g. by a re-INVITE
+        m_decodeBuffer.resize(frames * frameSamples);
+        audioDecoder->decode(rtpPayload.data, frames * audioDecoder->inBufSize,
+                m_decodeBuffer.data());
+        writeConverted(m_decodeBuffer.data(), m_decodeBuffer.size(),
+                audioDecoder->sampleRate);
+    }
+    m_concealedFrames = 0;
+
+    m_lastDuration = audioCodecDuration(codec,
+            frames * audioDecoder->inBufSize);
+    m_nextTimestamp = rtpPayload.timestamp + m_lastDuration;
+    m_hasTimestamp = true;
+}
+
+void RtpStreamDecoder::conceal(size_t ticks) {
+    size_t samples = ticks * m_sampleRate / Rtp_Clock_Rate;
+
+    // The stored G.711 bytes can not be faded, the gap stays silent.
+    if (m_encoding != ac_UNDEFINED) {
+        m_encodedSilence.assign(samples,
+                m_encoding == ac_PCMA ? G711_Alaw_Silence : G711_Ulaw_Silence);
+        writeEncoded(m_encodedSilence.data(), m_encodedSilence.size());
+        return;
+    }
+    size_t frameSamples =
+            m_lastFrame.empty() ? m_sampleRate / 100 : m_lastFrame.size();
+
+    while (samples > 0) {
+        size_t n = min(samples, frameSamples);
+        m_decodeBuffer.assign(n, 0);
+
+        if (m_concealedFrames < Plc_Frames && !m_lastFrame.empty()) {
+
+            // repeat the last frame, fading out linearly over Plc_Frames
+            int32_t from = (Plc_Frames - m_concealedFrames) * frameSamples;
+            int32_t den = Plc_Frames * frameSamples;
+            for (size_t i = 0; i < n; i++) {
+                m_decodeBuffer[i] = m_lastFrame[i] * (from - int32_t(i)) / den;
+            }
+        }
+        write(m_decodeBuffer.data(), n);
+        m_concealedFrames++;
+        samples -= n;
+    }
+}
+
+void RtpStreamDecoder::writeConverted(const short* samples, size_t n,
+        u_int sampleRate) {
+    m_convertBuffer.clear();
+    if (sampleRate * 2 == m_sampleRate) {
+
+        // linear interpolation of the sample in between
+        for (size_t i = 0; i < n; i++) {
+            m_convertBuffer.push_back((m_lastSample + samples[i]) / 2);
+            m_convertBuffer.push_back(samples[i]);
+            m_lastSample = samples[i];
+        }
+    } else if (sampleRate == m_sampleRate * 2) {
+
+        // mean of two samples
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            m_convertBuffer.push_back((samples[i] + samples[i + 1]) / 2);
+        }
+    } else {
+        L_e
+        << "Conversion from " << sampleRate << " Hz to " << m_sampleRate
+        << " Hz not supported.";
+        return;
+    }
+    if (m_convertBuffer.empty()) {
+        return;
+    }
+
+    write(m_convertBuffer.data(), m_convertBuffer.size());
+    keepLastFrame(m_convertBuffer.data(), m_convertBuffer.size(),
+            m_sampleRate / 100);
+}
+
+void RtpStreamDecoder::keepLastFrame(const short* samples, size_t n,
+        size_t frameSamples) {
+    if (n >= frameSamples) {
+        m_lastFrame.assign(samples + n - frameSamples, samples + n);
+        return;
+    }
+
+    // short packets, the frame continues the samples kept before
+    m_lastFrame.insert(m_lastFrame.end(), samples, samples + n);
+    if (m_lastFrame.size() > frameSamples) {
+        m_lastFrame.erase(m_lastFrame.begin(),
+                m_lastFrame.end() - frameSamples);
+    }
+}
+
+size_t RtpStreamDecoder::declare(size_t samples, short** buffer) {
+    void* space = NULL;
+    size_t n = 0;
+    if (m_memChunk) {
+        n = m_memChunk->declare(samples * sizeof(short), &space)
+                / sizeof(short);
+    }
+    if (!n) {
+
+        // memory chunk seems to be full, keep current memory chunk
+        if (m_memChunk) {
+            m_memChunkDeque.push_back(move(m_memChunk));
+        }
+
+        // take the next one from the pool
+        m_memChunk = m_memChunkPool->acquire();
+        n = m_memChunk->declare(samples * sizeof(short), &space)
+                / sizeof(short);
+    }
+    *buffer = reinterpret_cast<short*>(space);
+    return n;
+}
+
+void RtpStreamDecoder::commit(size_t samples) {
+    m_memChunk->commit(samples * sizeof(short));
+}
+
+void RtpStreamDecoder::write(const short* samples, size_t n) {
+    while (n > 0) {
+        short* buffer;
+        size_t count = declare(n, &buffer);
+        memcpy(buffer, samples, count * sizeof(short));
+        commit(count);
+        samples += count;
+        n -= count;
+    }
+}
+
+void RtpStreamDecoder::writeEncoded(const u_char* data, size_t n) {
+    while (n > 0) {
+        void* space = NULL;
+        size_t count = 0;
+        if (m_memChunk) {
+            count = m_memChunk->declare(n, &space);
+        }
+        if (!count) {
+            if (m_memChunk) {
+                m_memChunkDeque.push_back(move(m_memChunk));
+            }
+            m_memChunk = m_memChunkPool->acquire();
+            count = m_memChunk->declare(n, &space);
+        }
+        memcpy(space, data, count);
+        m_memChunk->commit(count);
+        data += count;
+        n -= count;
+    }
+}
+
+void RtpStreamDecoder::expand() {
+    if (m_memChunk && m_memChunk->fillingLevel() > 0) {
+        m_memChunkDeque.push_back(move(m_memChunk));
+    }
+    m_memChunk.reset();
+
+    AudioDecoderInterface* g711Decoder = decoder(m_encoding);
+    m_encoding = ac_UNDEFINED;
+
+    // the encoded MemChunks return to the pool one by one
+    MemChunkDeque encoded;
+    encoded.swap(m_memChunkDeque);
+    while (!encoded.empty()) {
+        size_t n = encoded.front()->fillingLevel();
+        m_decodeBuffer.resize(n);
+        g711Decoder->decode(reinterpret_cast<u_char*>(encoded.front()->data()),
+                n, m_decodeBuffer.data());
+        encoded.pop_front();
+        write(m_decodeBuffer.data(), n);
+    }
+}
+
+void RtpStreamDecoder::finish(PcmAudio& pcmAudio) {
+    if (m_sampleRate) {
+        pcmAudio.setSampleRate(m_sampleRate);
+    }
+    pcmAudio.setEncoding(m_encoding);
+
+    // keep last memory chunk if it is not empty
+    if (m_memChunk && m_memChunk->fillingLevel() > 0) {
+        m_memChunkDeque.push_back(move(m_memChunk));
+    }
+    m_memChunk.reset();
+
+    for (auto iter = m_memChunkDeque.begin(); iter != m_memChunkDeque.end();
+            iter++) {
+        pcmAudio.addChunk(*iter);
+    }
+    m_memChunkDeque.clear();
+}
+
+bool RtpStreamDecoder::firstTimestamp(uint32_t& ssrc,
+        uint32_t& timestamp) const {
+    if (!m_sampleRate) {
+        return false;
+    }
+    ssrc = m_firstSsrc;
+    timestamp = m_firstTimestamp;
+    return true;
+}
+
+u_int RtpStreamDecoder::seqNumErrors() const {
+    return m_seqNumErrors;
+}
+
+RtpStreamStats RtpStreamDecoder::stats() const {
+    RtpStreamStats stats = m_stats;
+    for (auto iter = m_sources.begin(); iter != m_sources.end(); iter++) {
+        stats += (*iter)->jitterBuffer.stats();
+    }
+    return stats;
+}
+
+AudioDecoderInterface* RtpStreamDecoder::decoder(audioCodecEnum codec) {
+    if (!m_decoders[codec] && AudioDecoderFactory::supports(codec)) {
+        m_decoders[codec] = m_decoderFactory->create(codec);
+    }
+    return m_decoders[codec].get();
+}
+
+} /* namespace callx */
@@ -0,0 +1,223 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpStreamDecoder.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef RTPSTREAMDECODER_HPP_
+#define RTPSTREAMDECODER_HPP_
+
+#include <memory>
+#include <vector>
+#include "audio.hpp"
+#include "AudioDecoderFactory.hpp"
+#include "PcmAudio.hpp"
+#include "RtpPayload.hpp"
+#include "RtpJitterBuffer.hpp"
+#include "MemChunkPool.hpp"
+
+namespace callx {
+
+/**
+ * Decodes the RTP packets of one media stream into MemChunks of the
+ * MemChunkPool, packet by
+ * packet. It is used by the AudioHandler for the stored payloads of a
+ * call and by the RtpSink in streaming mode (rtp_streaming_decode), where
+ * every packet is decoded on arrival.
+ *
+ * The packets are demultiplexed by SSRC and pass an RtpJitterBuffer per
+ * source. Only one source is decoded at a time: another source takes over
+ * after Switch_Packets packets in a row, e.g. after an SBC switched the
+ * media, while interleaved sources keep the current one. The decoded
+ * sources are stitched one after the other, each following its own RTP
+ * timestamps.
+ *
+ * Gaps in the RTP timestamps, lost packets as well as silence suppression,
+ * are filled with a faded repetition of the last frame and silence, so the
+ * audio keeps its timing. The output has the sample rate of the first
+ * decoded codec (8 or 16 kHz), later codecs are converted to it.
+ *
+ * With keepG711, a stream starting with G.711 is not decoded: the payload
+ * bytes are stored as they are and gaps are filled with the silence byte
+ * of the law. If another codec follows, the bytes stored so far are
+ * decoded and the stream continues as 16 bit PCM.
+ */
+class RtpStreamDecoder {
+public:
+
+    // longer gaps are not filled, e.g. timestamp jumps of a new source
+    static const size_t Max_Gap_Ticks = 5 * Rtp_Clock_Rate;
+
+    // frames repeated to conceal a loss, before silence is inserted
+    static const u_int Plc_Frames = 4;
+
+    // packets in a row which make another source the decoded one
+    static const u_int Switch_Packets = 5;
+
+    // sources tracked, the least recent one is replaced
+    static const size_t Max_Sources = 4;
+
+    /**
+     * @param keepG711 Store G.711 payloads without decoding them
+     * (wave_output_g711).
+     */
+    explicit RtpStreamDecoder(bool keepG711 = false);
+    virtual ~RtpStreamDecoder();
+
+    /**
+     * Decodes the payload of an RTP packet, as soon as it is in order.
+     * Unsupported payload types are skipped.
+     * @param payloadTypeMap Payload type mapping of the stream (SDP).
+     * @param rtpPayload
+     */
+    void decode(const PayloadTypeMap& payloadTypeMap,
+            const RtpPayload& rtpPayload);
+
+    /**
+     * Decodes the packets still waiting for a missing one.
+     * @param payloadTypeMap Payload type mapping of the stream (SDP).
+     */
+    void flush(const PayloadTypeMap& payloadTypeMap);
+
+    /**
+     * Moves the decoded audio, its sample rate and encoding into pcmAudio.
+     * @param pcmAudio
+     */
+    void finish(PcmAudio& pcmAudio);
+
+    /**
+     * RTP timestamp of the first decoded sample.
+     * @param ssrc Source of the first decoded packet.
+     * @param timestamp
+     * @return False, if no audio has been decoded.
+     */
+    bool firstTimestamp(uint32_t& ssrc, uint32_t& timestamp) const;
+
+    /**
+     * Number of RTP sequence number gaps seen so far.
+     */
+    u_int seqNumErrors() const;
+
+    /**
+     * Loss, reorder, duplicate and SSRC change counters of the stream.
+     */
+    RtpStreamStats stats() const;
+
+private:
+
+    // one sender (SSRC) of the stream
+    struct Source {
+        uint32_t ssrc;
+        RtpJitterBuffer jitterBuffer;
+
+        // packets in a row and number of the last packet
+        u_int packetsInRow;
+        size_t lastPacket;
+    };
+
+    // the source of ssrc, a new one if not yet known
+    Source& source(uint32_t ssrc);
+
+    // decodes the packets of the active source which are in order
+    void decodeActive(const PayloadTypeMap& payloadTypeMap, bool flush);
+
+    void decodeInOrder(const PayloadTypeMap& payloadTypeMap,
+            const RtpPayload& rtpPayload, u_int missing, bool restart);
+
+    // writes concealment audio, ticks of the RTP clock long
+    void conceal(size_t ticks);
+
+    // writes the samples converted to the sample rate of the stream
+    void writeConverted(const short* samples, size_t n, u_int sampleRate);
+
+    // keeps the last frameSamples of the decoded audio for the concealment
+    void keepLastFrame(const short* samples, size_t n, size_t frameSamples);
+
+    // space for up to samples in the current MemChunk, a full one is
+    // replaced by a new MemChunk
+    size_t declare(size_t samples, short** buffer);
+
+    // stores samples written to the space handed out by declare()
+    void commit(size_t samples);
+
+    // copies the samples, spanning MemChunks if necessary
+    void write(const short* samples, size_t n);
+
+    // copies G.711 bytes, spanning MemChunks if necessary
+    void writeEncoded(const u_char* data, size_t n);
+
+    // decodes the G.711 bytes stored so far, the stream continues as PCM
+    void expand();
+
+    // decoder of the codec, NULL if not supported
+    AudioDecoderInterface* decoder(audioCodecEnum codec);
+
+    MemChunkPool* m_memChunkPool;
+    std::shared_ptr<MemChunk> m_memChunk;
+    MemChunkDeque m_memChunkDeque;
+
+    // decoders of the stream, created on first use
+    AudioDecoderFactory* m_decoderFactory;
+    AudioDecoderPtr m_decoders[ac_TELEPHONE_EVENT + 1];
+
+    std::vector<std::unique_ptr<Source> > m_sources;
+    Source* m_activeSource;
+    bool m_sourceSwitched;
+    size_t m_packets;
+    RtpStreamStats m_stats;
+    u_int m_seqNumErrors;
+
+    // expected timestamp and duration of the last decoded packet
+    bool m_hasTimestamp;
+    uint32_t m_nextTimestamp;
+    size_t m_lastDuration;
+
+    // sample rate of the output, 0 until the first audio is decoded
+    u_int m_sampleRate;
+
+    // G.711 payloads are stored as they are (ac_PCMA, ac_PCMU) if the
+    // stream starts with them, ac_UNDEFINED: 16 bit PCM
+    bool m_keepG711;
+    audioCodecEnum m_encoding;
+    std::vector<u_char> m_encodedSilence;
+
+    // first decoded packet, the start of the output
+    uint32_t m_firstSsrc;
+    uint32_t m_firstTimestamp;
+
+    // decoder output and its conversion, if the sample rate differs
+    std::vector<short> m_decodeBuffer;
+    std::vector<short> m_convertBuffer;
+    short m_lastSample;
+
+    // last decoded frame and number of frames concealed since
+    std::vector<short> m_lastFrame;
+    u_int m_concealedFrames;
+};
+
+} /* namespace callx */
+
+#endif /* RTPSTREAMDECODER_HPP_ */
@@ -0,0 +1,170 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * StereoPcmMerger.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "StereoPcmMerger.hpp"
+#include "MemChunk.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace callx {
+
+StereoPcmMerger::StereoPcmMerger() {
+}
+
+StereoPcmMerger::~StereoPcmMerger() {
+}
+
+void StereoPcmMerger::add(unique_ptr<PcmAudio> pcmAudio,
+        const systemClock::time_point& startTs) {
+    unique_ptr<Piece> piece(new Piece());
+    piece->startTs = startTs;
+    piece->offset = 0;
+    piece->length = 0;
+    piece->factor = 1;
+    piece->chunkPos = 0;
+    piece->produced = 0;
+    piece->prevSample = 0;
+    piece->currSample = 0;
+
+    int channel = pcmAudio->isCallerAudio() ? 0 : 1;
+    piece->pcmAudio = move(pcmAudio);
+    m_pieces[channel].push_back(move(piece));
+}
+
+bool StereoPcmMerger::merge(PcmAudio& stereoAudio) {
+
+    // common start and sample rate
+    bool empty = true;
+    systemClock::time_point startTs;
+    u_int sampleRate = 0;
+    for (int channel = 0; channel < 2; channel++) {
+        for (auto iter = m_pieces[channel].begin();
+                iter != m_pieces[channel].end(); iter++) {
+            if (empty || (*iter)->startTs < startTs) {
+                startTs = (*iter)->startTs;
+            }
+            sampleRate = max(sampleRate, (*iter)->pcmAudio->getSampleRate());
+            empty = false;
+        }
+    }
+    if (empty) {
+        return false;
+    }
+
+    // place the pieces on the time line
+    size_t total = 0;
+    for (int channel = 0; channel < 2; channel++) {
+        for (auto iter = m_pieces[channel].begin();
+                iter != m_pieces[channel].end(); iter++) {
+            Piece& piece = **iter;
+            piece.factor = sampleRate / piece.pcmAudio->getSampleRate();
+            int64_t micros = boost::chrono::duration_cast<
+                    boost::chrono::microseconds>(piece.startTs - startTs)
+                    .count();
+            piece.offset = micros * sampleRate / 1000000;
+
+            auto memChunkDeque = piece.pcmAudio->getChunkDeque();
+            for (auto chunk = memChunkDeque->begin();
+                    chunk != memChunkDeque->end(); chunk++) {
+                piece.length += (*chunk)->fillingLevel() / sizeof(short);
+            }
+            piece.length *= piece.factor;
+            total = max(total, piece.offset + piece.length);
+        }
+    }
+
+    stereoAudio.setSampleRate(sampleRate);
+    stereoAudio.setChannels(2);
+
+    // merge block by block, interleaving the channels
+    vector<short> left(Block_Samples);
+    vector<short> right(Block_Samples);
+    vector<short> interleaved(2 * Block_Samples);
+    for (size_t pos = 0; pos < total; pos += Block_Samples) {
+        size_t n = min(size_t(Block_Samples), total - pos);
+        fill(0, pos, n, left.data());
+        fill(1, pos, n, right.data());
+        for (size_t i = 0; i < n; i++) {
+            interleaved[2 * i] = left[i];
+            interleaved[2 * i + 1] = right[i];
+        }
+        stereoAudio.append(interleaved.data(), 2 * n);
+    }
+
+    m_pieces[0].clear();
+    m_pieces[1].clear();
+    return true;
+}
+
+void StereoPcmMerger::fill(int channel, size_t pos, size_t n, short* out) {
+    memset(out, 0, n * sizeof(short));
+    for (auto iter = m_pieces[channel].begin();
+            iter != m_pieces[channel].end(); iter++) {
+        Piece& piece = **iter;
+        size_t from = max(pos, piece.offset);
+        size_t to = min(pos + n, piece.offset + piece.length);
+        if (from < to) {
+            read(piece, out + (from - pos), to - from);
+        }
+    }
+}
+
+void StereoPcmMerger::read(Piece& piece, short* out, size_t n) {
+    auto memChunkDeque = piece.pcmAudio->getChunkDeque();
+    for (size_t i = 0; i < n; i++) {
+        u_int phase = piece.produced % piece.factor;
+        if (phase == 0) {
+
+            // next sample of the piece, merged chunks are released
+            while (piece.chunkPos * sizeof(short)
+                    >= memChunkDeque->front()->fillingLevel()) {
+                memChunkDeque->pop_front();
+                piece.chunkPos = 0;
+            }
+            short* samples =
+                    reinterpret_cast<short*>(memChunkDeque->front()->data());
+            piece.prevSample = piece.currSample;
+            piece.currSample = samples[piece.chunkPos++];
+        }
+        piece.produced++;
+
+        // linear interpolation, if the piece has a lower sample rate
+        int32_t sample = piece.prevSample
+                + (piece.currSample - piece.prevSample) * int32_t(phase + 1)
+                        / int32_t(piece.factor);
+
+        // mix, saturating
+        sample += out[i];
+        out[i] = short(max(-32768, min(32767, sample)));
+    }
+}
+
+} /* namespace callx */
@@ -0,0 +1,109 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * StereoPcmMerger.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef STEREOPCMMERGER_HPP_
+#define STEREOPCMMERGER_HPP_
+
+#include <memory>
+#include <vector>
+#include "main/CallxTypes.hpp"
+#include "PcmAudio.hpp"
+
+namespace callx {
+
+/**
+ * Merges the decoded audio of all RtpSinks of a call into one time-aligned
+ * stereo PcmAudio, the caller on the left and the callee on the right
+ * channel. Every piece is placed at the offset of its arrival time, gaps
+ * are filled with silence and overlapping pieces of a channel are mixed.
+ * Pieces at 8 kHz are interpolated if the other pieces are wideband. The
+ * MemChunks of a piece are released as soon as they have been merged.
+ */
+class StereoPcmMerger {
+public:
+
+    // samples per channel merged at once
+    static const size_t Block_Samples = 4096;
+
+    StereoPcmMerger();
+    virtual ~StereoPcmMerger();
+
+    /**
+     * Adds the decoded audio of one RtpSink.
+     * @param pcmAudio Mono audio of the caller or the callee.
+     * @param startTs Arrival time of the first sample.
+     */
+    void add(std::unique_ptr<PcmAudio> pcmAudio,
+            const systemClock::time_point& startTs);
+
+    /**
+     * Merges the added audio into stereoAudio, starting at the earliest
+     * piece.
+     * @param stereoAudio Receives the interleaved samples, the sample rate
+     * and 2 channels.
+     * @return False, if no audio has been added.
+     */
+    bool merge(PcmAudio& stereoAudio);
+
+private:
+
+    // audio of one RtpSink and its read position
+    struct Piece {
+        std::unique_ptr<PcmAudio> pcmAudio;
+        systemClock::time_point startTs;
+
+        // first sample and length on the merged time line
+        size_t offset;
+        size_t length;
+
+        // merged samples per sample of the piece
+        u_int factor;
+
+        // samples read from the front MemChunk and samples produced
+        size_t chunkPos;
+        size_t produced;
+
+        // the last two samples read, interpolated with factor > 1
+        short prevSample;
+        short currSample;
+    };
+
+    // mixes n samples of the piece into out
+    void read(Piece& piece, short* out, size_t n);
+
+    // samples [pos, pos + n) of a channel
+    void fill(int channel, size_t pos, size_t n, short* out);
+
+    // left: caller, right: callee
+    std::vector<std::unique_ptr<Piece> > m_pieces[2];
+};
+
+} /* namespace callx */
+
+#endif /* STEREOPCMMERGER_HPP_ */
@@ -0,0 +1,294 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * VoiceActivityDetector.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "VoiceActivityDetector.hpp"
+#include "MemChunk.hpp"
+#include "main/callx.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VAD_X86_KERNELS
+#endif
+
+using namespace std;
+
+namespace callx {
+
+#ifdef VAD_X86_KERNELS
+
+// The squares are taken of the halved samples, so a pair of them fits the
+// 32 bit lanes of madd. A sign change between neighbours is the sign bit
+// of their xor; the second load is the samples shifted by one.
+
+__attribute__((target("sse2")))
+static void analyseSse2(const short* samples, size_t n, float& energy,
+        u_int& crossings) {
+    __m128 acc = _mm_setzero_ps();
+    __m128i signChanges = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 9 <= n; i += 8) {
+        __m128i x = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(samples + i));
+        __m128i next = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(samples + i + 1));
+        __m128i half = _mm_srai_epi16(x, 1);
+        acc = _mm_add_ps(acc, _mm_cvtepi32_ps(_mm_madd_epi16(half, half)));
+        signChanges = _mm_sub_epi16(signChanges,
+                _mm_srai_epi16(_mm_xor_si128(x, next), 15));
+    }
+    float sum[4];
+    _mm_storeu_ps(sum, acc);
+    u_short counts[8];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(counts), signChanges);
+
+    VoiceActivityDetector::analyseScalar(samples + i, n - i, energy,
+            crossings);
+    energy += 4 * ((sum[0] + sum[1]) + (sum[2] + sum[3]));
+    for (int k = 0; k < 8; k++) {
+        crossings += counts[k];
+    }
+}
+
+__attribute__((target("avx2")))
+static void analyseAvx2(const short* samples, size_t n, float& energy,
+        u_int& crossings) {
+    __m256 acc = _mm256_setzero_ps();
+    __m256i signChanges = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 17 <= n; i += 16) {
+        __m256i x = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(samples + i));
+        __m256i next = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(samples + i + 1));
+        __m256i half = _mm256_srai_epi16(x, 1);
+        acc = _mm256_add_ps(acc,
+                _mm256_cvtepi32_ps(_mm256_madd_epi16(half, half)));
+        signChanges = _mm256_sub_epi16(signChanges,
+                _mm256_srai_epi16(_mm256_xor_si256(x, next), 15));
+    }
+    float sum[8];
+    _mm256_storeu_ps(sum, acc);
+    u_short counts[16];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(counts), signChanges);
+
+    VoiceActivityDetector::analyseScalar(samples + i, n - i, energy,
+            crossings);
+    for (int k = 0; k < 8; k++) {
+        energy += 4 * sum[k];
+    }
+    for (int k = 0; k < 16; k++) {
+        crossings += counts[k];
+    }
+}
+
+#endif
+
+// frame analysis kernel, selected once by the CPU features
+struct VadKernel {
+    VoiceActivityDetector::Kernel analyse;
+    const char* name;
+};
+
+static const VadKernel& vadKernel() {
+    static const VadKernel kernel = []() {
+#ifdef VAD_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return VadKernel { analyseAvx2, "avx2" };
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return VadKernel { analyseSse2, "sse2" };
+        }
+#endif
+        return VadKernel { VoiceActivityDetector::analyseScalar, "scalar" };
+    }();
+    return kernel;
+}
+
+VoiceActivityDetector::VoiceActivityDetector(int thresholdDb,
+        u_int maxSilenceMs)
+        : m_maxSilenceMs(maxSilenceMs),
+          m_kernel(vadKernel().analyse) {
+    float fullScale = 32768.0f * 32768.0f;
+    m_threshold = fullScale * pow(10.0f, thresholdDb / 10.0f);
+    m_loudThreshold = fullScale
+            * pow(10.0f, (thresholdDb + Loud_Margin_Db) / 10.0f);
+}
+
+VoiceActivityDetector::~VoiceActivityDetector() {
+}
+
+const char* VoiceActivityDetector::kernelName() {
+    return vadKernel().name;
+}
+
+void VoiceActivityDetector::analyseScalar(const short* samples, size_t n,
+        float& energy, u_int& crossings) {
+    energy = 0;
+    crossings = 0;
+    for (size_t i = 0; i < n; i++) {
+        energy += float(int32_t(samples[i]) * samples[i]);
+    }
+    for (size_t i = 0; i + 1 < n; i++) {
+        crossings += (samples[i] ^ samples[i + 1]) < 0;
+    }
+}
+
+bool VoiceActivityDetector::isVoiced(const short* samples, size_t n) const {
+    if (!n) {
+        return false;
+    }
+    float energy;
+    u_int crossings;
+    m_kernel(samples, n, energy, crossings);
+
+    float meanSquare = energy / n;
+    if (meanSquare >= m_loudThreshold) {
+        return true;
+    }
+    if (meanSquare < m_threshold) {
+        return false;
+    }
+    return crossings * 100 < Noise_Crossings * n;
+}
+
+size_t VoiceActivityDetector::process(PcmAudio& pcmAudio) {
+    u_short channels = pcmAudio.getChannels();
+    size_t frameSize = pcmAudio.getSampleRate() * Frame_Ms / 1000 * channels;
+    size_t maxSilence = size_t(pcmAudio.getSampleRate()) * m_maxSilenceMs
+            / 1000 * channels;
+    auto memChunkDeque = pcmAudio.getChunkDeque();
+    if (!frameSize || memChunkDeque->empty()) {
+        return 0;
+    }
+
+    // The kept samples are written back behind the read position, chunk
+    // lengths are those before the compaction.
+    vector<size_t> lengths;
+    for (auto iter = memChunkDeque->begin(); iter != memChunkDeque->end();
+            iter++) {
+        lengths.push_back((*iter)->fillingLevel() / sizeof(short));
+    }
+    size_t readChunk = 0;
+    size_t readPos = 0;
+    size_t writeChunk = 0;
+    size_t writePos = 0;
+    size_t written = 0;
+    size_t removed = 0;
+
+    m_frame.resize(frameSize);
+    m_channel.resize(frameSize / channels);
+    u_int hangover = 0;
+    size_t silence = 0;
+    while (readChunk < lengths.size()) {
+
+        // next frame, it may span chunks
+        size_t n = 0;
+        while (n < frameSize && readChunk < lengths.size()) {
+            size_t count = min(frameSize - n, lengths[readChunk] - readPos);
+            memcpy(&m_frame[n],
+                    reinterpret_cast<short*>((*memChunkDeque)[readChunk]->data())
+                            + readPos, count * sizeof(short));
+            n += count;
+            readPos += count;
+            if (readPos == lengths[readChunk]) {
+                readChunk++;
+                readPos = 0;
+            }
+        }
+        // An incomplete group of channels can only end the audio, it is
+        // not classified and kept in any case.
+        size_t whole = n - n % channels;
+
+        bool voiced = false;
+        for (u_short channel = 0; channel < channels && !voiced; channel++) {
+            size_t samples = 0;
+            for (size_t i = channel; i < whole; i += channels) {
+                m_channel[samples++] = m_frame[i];
+            }
+            voiced = isVoiced(m_channel.data(), samples);
+        }
+        if (voiced) {
+            hangover = Hangover_Frames;
+        } else if (hangover > 0) {
+            hangover--;
+            voiced = true;
+        }
+
+        size_t keep = n;
+        if (voiced) {
+            silence = 0;
+        } else {
+            keep = min(whole, maxSilence - silence);
+            if (keep) {
+                pcmAudio.addSilence(written / channels, keep / channels);
+            }
+            silence += keep;
+            removed += whole - keep;
+            if (whole < n) {
+                copy(&m_frame[whole], &m_frame[n], &m_frame[keep]);
+                keep += n - whole;
+            }
+        }
+
+        // write back
+        for (size_t done = 0; done < keep;) {
+            if (writePos == lengths[writeChunk]) {
+                writeChunk++;
+                writePos = 0;
+            }
+            size_t count = min(keep - done, lengths[writeChunk] - writePos);
+            memmove(reinterpret_cast<short*>((*memChunkDeque)[writeChunk]
+                    ->data()) + writePos, &m_frame[done],
+                    count * sizeof(short));
+            done += count;
+            writePos += count;
+        }
+        written += keep;
+    }
+
+    // nothing kept, e.g. silence only and maxSilenceMs 0
+    if (!written) {
+        memChunkDeque->clear();
+        return removed / channels;
+    }
+
+    // shorten the last written chunk, release the ones behind it; the
+    // write position only moves on to a chunk that is written to
+    (*memChunkDeque)[writeChunk]->clear();
+    (*memChunkDeque)[writeChunk]->commit(writePos * sizeof(short));
+    memChunkDeque->resize(writeChunk + 1);
+
+    return removed / channels;
+}
+
+} /* namespace callx */
@@ -0,0 +1,116 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * VoiceActivityDetector.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef VOICEACTIVITYDETECTOR_HPP_
+#define VOICEACTIVITYDETECTOR_HPP_
+
+#include <vector>
+#include "main/CallxTypes.hpp"
+#include "PcmAudio.hpp"
+
+namespace callx {
+
+/**
+ * Removes silence from decoded audio: ringback gaps, hold and the silent
+ * side of a call. The audio is classified in frames of Frame_Ms by their
+ * energy and zero crossing rate; a frame is voiced if it is louder than
+ * the threshold, unless it is just above it and crosses zero as often as
+ * noise does. Hangover_Frames after a voiced frame are kept as well, so
+ * word endings are not cut.
+ *
+ * Silent spans are dropped or shortened to maxSilenceMs, in place of the
+ * MemChunks. The kept silent spans are recorded in the PcmAudio, so the
+ * socket output can count voiced seconds only. Stereo audio is voiced if
+ * one of its channels is.
+ */
+class VoiceActivityDetector {
+public:
+
+    static const u_int Frame_Ms = 10;
+
+    // frames kept after the last voiced frame
+    static const u_int Hangover_Frames = 20;
+
+    // zero crossings per 100 samples above which a quiet frame is noise
+    static const u_int Noise_Crossings = 40;
+
+    // frames this much above the threshold are voiced in any case
+    static const int Loud_Margin_Db = 12;
+
+    /**
+     * @param thresholdDb Frame energy threshold in dBFS.
+     * @param maxSilenceMs Silent spans are shortened to this length, 0
+     * drops them.
+     */
+    VoiceActivityDetector(int thresholdDb, u_int maxSilenceMs);
+    virtual ~VoiceActivityDetector();
+
+    /**
+     * Drops or shortens the silent spans of the audio. Emptied MemChunks
+     * return to the MemChunkPool.
+     * @param pcmAudio
+     * @return Number of samples per channel removed.
+     */
+    size_t process(PcmAudio& pcmAudio);
+
+    /**
+     * Classifies one frame of mono audio.
+     * @param samples
+     * @param n Number of samples.
+     * @return True, if the frame is voiced.
+     */
+    bool isVoiced(const short* samples, size_t n) const;
+
+    /**
+     * Name of the frame analysis kernel in use, e.g. "avx2".
+     */
+    static const char* kernelName();
+
+    typedef void (*Kernel)(const short* samples, size_t n, float& energy,
+            u_int& crossings);
+
+    // sum of squares and sign changes of the samples
+    static void analyseScalar(const short* samples, size_t n, float& energy,
+            u_int& crossings);
+
+private:
+
+    // mean square of a frame at the threshold and the loud margin
+    float m_threshold;
+    float m_loudThreshold;
+    u_int m_maxSilenceMs;
+    Kernel m_kernel;
+
+    std::vector<short> m_frame;
+    std::vector<short> m_channel;
+};
+
+} /* namespace callx */
+
+#endif /* VOICEACTIVITYDETECTOR_HPP_ */
@@ -0,0 +1,138 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * audio.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef AUDIO_HPP_
+#define AUDIO_HPP_
+
+#include <sys/types.h>
+#include <strings.h>
+#include <string>
+
+namespace callx {
+
+// Static RTP payload types, RFC 3551 (pt_)
+enum rtpPayloadTypeEnum {
+    pt_PCMU = 0,
+    pt_GSM = 3,
+    pt_PCMA = 8,
+    pt_G722 = 9,
+    pt_UNDEFINED = 127
+};
+
+// Audio Codec (ac_)
+enum audioCodecEnum {
+    ac_UNDEFINED = 0,
+    ac_PCMU,
+    ac_PCMA,
+    ac_GSM,
+    ac_G722,
+    ac_TELEPHONE_EVENT
+};
+static const std::string audioCodec[] = { "UNDEFINED", "PCMU", "PCMA", "GSM",
+        "G722", "TELEPHONE-EVENT" };
+
+inline std::string audioCodecEnumToString(audioCodecEnum c) {
+    return audioCodec[c];
+}
+
+// RTP clock rate of the supported audio codecs, G.722 included (RFC 3551)
+const u_int Rtp_Clock_Rate = 8000;
+
+// GSM 06.10 frame: 33 bytes, 160 samples (RFC 3551)
+const size_t Gsm_Frame_Size = 33;
+const size_t Gsm_Frame_Samples = 160;
+
+// G.711 codes of the zero sample (A-law: the smallest positive one)
+const u_char G711_Alaw_Silence = 0xD5;
+const u_char G711_Ulaw_Silence = 0xFF;
+
+/**
+ * Audio duration of an RTP payload in RTP clock ticks, 0 for payloads
+ * without audio (e.g. telephone events).
+ */
+inline size_t audioCodecDuration(audioCodecEnum codec, size_t payloadSize) {
+    switch (codec) {
+    case ac_PCMU:
+    case ac_PCMA:
+    case ac_G722:
+        return payloadSize;
+    case ac_GSM:
+        return payloadSize / Gsm_Frame_Size * Gsm_Frame_Samples;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Maps an encoding name of an a=rtpmap attribute to a codec. Encoding names
+ * are case-insensitive (RFC 4566).
+ */
+inline audioCodecEnum audioCodecNameToEnum(const char* name, size_t len) {
+    for (int c = ac_PCMU; c <= ac_TELEPHONE_EVENT; c++) {
+        if (audioCodec[c].size() == len
+                && strncasecmp(audioCodec[c].c_str(), name, len) == 0) {
+            return static_cast<audioCodecEnum>(c);
+        }
+    }
+    return ac_UNDEFINED;
+}
+
+/**
+ * RTP payload type to codec mapping of one media stream. It starts with
+ * the static payload types and is completed by the a=rtpmap attributes
+ * of the session description.
+ */
+class PayloadTypeMap {
+public:
+
+    PayloadTypeMap() {
+        for (int pt = 0; pt < 128; pt++) {
+            m_codec[pt] = ac_UNDEFINED;
+        }
+        m_codec[pt_PCMU] = ac_PCMU;
+        m_codec[pt_GSM] = ac_GSM;
+        m_codec[pt_PCMA] = ac_PCMA;
+        m_codec[pt_G722] = ac_G722;
+    }
+
+    void setCodec(u_char payloadType, audioCodecEnum codec) {
+        m_codec[payloadType & 0x7F] = codec;
+    }
+
+    audioCodecEnum getCodec(u_char payloadType) const {
+        return static_cast<audioCodecEnum>(m_codec[payloadType & 0x7F]);
+    }
+
+private:
+    u_char m_codec[128];
+};
+
+} /* namespace callx */
+
+#endif /* AUDIO_HPP_ */
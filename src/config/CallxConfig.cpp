@@ -44,17 +44,29 @@ CallxConfig::CallxConfig()
           pcap_filter("udp"),
           min_sip_size(300),
           tp_repository_size(1000000),
+          sp_repository_size(1000),
           mem_chunk_size(1024),
+          mem_chunk_pool_size(1024),
+          rtp_streaming_decode(false),
+          audio_handler_threads(2),
+          resample_rate(0),
+          resample_filter_length(16),
+          use_vad(false),
+          vad_threshold_db(-45),
+          vad_max_silence_ms(0),
           sba_pause(60),
           record_if_incident_only(false),
           record_caller(true),
           record_callee(false),
           use_wavefile_output_interface(true),
           wave_output_path("/var/spool/callx/output/"),
+          wave_output_stereo(false),
+          wave_output_g711(false),
           use_socket_output_interface(false),
           socket_output_remote_ip(""),
           socket_output_remote_port(0),
           socket_output_send_seconds(6),
+          capture_budget_seconds(0),
           use_viat_db(false),
           viat_db_connect_str(""),
           start_console(true),
@@ -64,6 +76,10 @@ CallxConfig::CallxConfig()
           max_call_age(3600),
           max_call_age_if_error(30),
           max_call_rtp_inactivity(90),
+          max_ood_transaction_age(32),
+          max_transaction_inactivity(180),
+          sip_retransmission_window(32),
+          call_map_shards(16),
 
           sba_call_attempts_period(100),
           sba_call_attempts_max(60),
@@ -107,7 +123,37 @@ void CallxConfig::init(string configFile) {
     min_sip_size = m_config.getInt("min_sip_size", min_sip_size);
     tp_repository_size = m_config.getInt("tp_repository_size",
             tp_repository_size);
+    sp_repository_size = m_config.getInt("sp_repository_size",
+            sp_repository_size);
     mem_chunk_size = m_config.getInt("mem_chunk_size", mem_chunk_size);
+    if (mem_chunk_size < 1024) {
+        throw("Config error: mem_chunk_size must be at least 1024.");
+    }
+    mem_chunk_pool_size = m_config.getInt("mem_chunk_pool_size",
+            mem_chunk_pool_size);
+    rtp_streaming_decode = m_config.getBool("rtp_streaming_decode",
+            rtp_streaming_decode);
+    audio_handler_threads = m_config.getInt("audio_handler_threads",
+            audio_handler_threads);
+    if (audio_handler_threads < 1) {
+        throw("Config error: audio_handler_threads must be at least 1.");
+    }
+    resample_rate = m_config.getInt("resample_rate", resample_rate);
+    if (resample_rate && (resample_rate < 8000 || resample_rate > 48000)) {
+        throw("Config error: resample_rate must be 0 or between 8000 and 48000.");
+    }
+    resample_filter_length = m_config.getInt("resample_filter_length",
+            resample_filter_length);
+    if (resample_filter_length < 4 || resample_filter_length > 256) {
+        throw("Config error: resample_filter_length must be between 4 and 256.");
+    }
+    use_vad = m_config.getBool("use_vad", use_vad);
+    vad_threshold_db = m_config.getInt("vad_threshold_db", vad_threshold_db);
+    vad_max_silence_ms = m_config.getInt("vad_max_silence_ms",
+            vad_max_silence_ms);
+    if (vad_max_silence_ms < 0) {
+        throw("Config error: vad_max_silence_ms must not be negative.");
+    }
     sba_pause = m_config.getInt("sba_pause", sba_pause);
     record_if_incident_only = m_config.getBool("record_if_incident_only");
     record_caller = m_config.getBool("record_caller");
@@ -116,6 +162,9 @@ void CallxConfig::init(string configFile) {
             m_config.getBool("use_wavefile_output_interface",
                     use_wavefile_output_interface);
     wave_output_path = m_config.getStr("wave_output_path", wave_output_path);
+    wave_output_stereo = m_config.getBool("wave_output_stereo",
+            wave_output_stereo);
+    wave_output_g711 = m_config.getBool("wave_output_g711", wave_output_g711);
     use_socket_output_interface =
             m_config.getBool("use_socket_output_interface",
                     use_socket_output_interface);
@@ -131,6 +180,16 @@ void CallxConfig::init(string configFile) {
     max_call_age = m_config.getInt("max_call_age");
     max_call_age_if_error = m_config.getInt("max_call_age_if_error");
     max_call_rtp_inactivity = m_config.getInt("max_call_rtp_inactivity");
+    max_ood_transaction_age = m_config.getInt("max_ood_transaction_age",
+            max_ood_transaction_age);
+    max_transaction_inactivity = m_config.getInt("max_transaction_inactivity",
+            max_transaction_inactivity);
+    sip_retransmission_window = m_config.getInt("sip_retransmission_window",
+            sip_retransmission_window);
+    call_map_shards = m_config.getInt("call_map_shards", call_map_shards);
+    if (call_map_shards < 1) {
+        throw("Config error: call_map_shards must be at least 1.");
+    }
 
     sba_call_attempts_period = m_config.getInt("sba_call_attempts_period",
             sba_call_attempts_period);
@@ -193,6 +252,19 @@ void CallxConfig::init(string configFile) {
     }
     ensureSlash(wave_output_path);
 
+    if (wave_output_stereo && !use_wavefile_output_interface) {
+        throw("Config error: wave_output_stereo is true but use_wavefile_output_interface is false.");
+    }
+
+    if (wave_output_g711 && !use_wavefile_output_interface) {
+        throw("Config error: wave_output_g711 is true but use_wavefile_output_interface is false.");
+    }
+
+    if (wave_output_g711
+            && (wave_output_stereo || resample_rate || use_vad)) {
+        throw("Config error: wave_output_g711 can not be combined with wave_output_stereo, resample_rate or use_vad.");
+    }
+
     if (use_socket_output_interface && !use_viat_db) {
         throw("Config error: use_socket_output_interface is true but use_viat_db is false.");
     }
@@ -201,6 +273,17 @@ void CallxConfig::init(string configFile) {
         throw("Config error: use_socket_output_interface is true but viat_db_connect_str is not set.");
     }
 
+    // The socket output sends the first socket_output_send_seconds of every
+    // stream, the wave file output writes the whole recording.
+    // With the VAD only voiced seconds count, silence is captured on top.
+    capture_budget_seconds = 0;
+    if (use_socket_output_interface && !use_wavefile_output_interface) {
+        capture_budget_seconds = socket_output_send_seconds;
+        if (use_vad) {
+            capture_budget_seconds *= Vad_Capture_Factor;
+        }
+    }
+
     if (sba_pause < 0) {
         throw("Config error: sba_pause has to be greater zero.");
     }
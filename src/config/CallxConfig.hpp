@@ -72,9 +72,39 @@ public:
     // created at startup. 1.000.000 need 1,8 GB of memory).
     int tp_repository_size;
 
+    // SipPacketRepository size (how many SipPacket objects are created at
+    // startup). The repository grows on demand if it runs empty.
+    int sp_repository_size;
+
     // memory chunk size used by the decoder for PCM data
     int mem_chunk_size;
 
+    // number of free memory chunks kept for reuse
+    int mem_chunk_pool_size;
+
+    // Decode RTP packets on arrival instead of storing them until the end
+    // of the call.
+    bool rtp_streaming_decode;
+
+    // number of AudioHandler threads decoding finished calls concurrently
+    int audio_handler_threads;
+
+    // sample rate the decoded audio is converted to, 0: keep the rate of
+    // the codec
+    int resample_rate;
+
+    // taps per phase of the polyphase resampling filter
+    int resample_filter_length;
+
+    // drop or shorten silence before the output (voice activity detection)
+    bool use_vad;
+
+    // frame energy in dBFS below which audio counts as silence
+    int vad_threshold_db;
+
+    // silent spans are shortened to this length, 0 drops them [ms]
+    int vad_max_silence_ms;
+
     // SBA pause between runs in seconds
     int sba_pause;
 
@@ -93,6 +123,12 @@ public:
     // path for output files
     std::string wave_output_path;
 
+    // write caller and callee of a call into one time-aligned stereo file
+    bool wave_output_stereo;
+
+    // write G.711 calls as A-law/u-law wavefiles without decoding them
+    bool wave_output_g711;
+
     // socket output interface
     bool use_socket_output_interface;
 
@@ -102,10 +138,17 @@ public:
     // port of feature extractor
     int socket_output_remote_port;
 
-    // number of seconds of audio material (16 bit samples, 8kHz sampling rate)
-    // to be sent to the feature extractor
+    // number of seconds of audio material (16 bit samples, 8kHz sampling rate
+    // or 16kHz for wideband codecs) to be sent to the feature extractor
     int socket_output_send_seconds;
 
+    // Seconds of audio captured per RTP stream, derived from the enabled
+    // outputs: socket_output_send_seconds (Vad_Capture_Factor times that
+    // with the VAD) if the socket output is the only consumer of the audio,
+    // 0 (unlimited) otherwise.
+    int capture_budget_seconds;
+    static const int Vad_Capture_Factor = 3;
+
     //
     bool use_viat_db;
 
@@ -137,6 +180,22 @@ public:
     // CallDecodeQueue and later be deleted.
     int max_call_rtp_inactivity;
 
+    // The maximum number of seconds an out-of-dialog transaction (OPTIONS,
+    // REGISTER) is tracked without a final response.
+    int max_ood_transaction_age;
+
+    // The maximum number of seconds a transaction of a call is kept without
+    // any matching SIP message.
+    int max_transaction_inactivity;
+
+    // Time window in seconds in which an identical SIP message is treated as
+    // retransmission and discarded.
+    int sip_retransmission_window;
+
+    // Number of CallMap shards, each with its own lock (rounded up to a
+    // power of two).
+    int call_map_shards;
+
     // ***************************************
     // --- Call attemps --------------------->
 
@@ -34,13 +34,20 @@
 #include "container/PcapPacketQueue.hpp"
 #include "container/UdpPacketQueue.hpp"
 #include "container/SipPacketQueue.hpp"
+#include "container/SipPacketRepository.hpp"
+#include "container/TimeoutWheel.hpp"
+#include "container/InternPool.hpp"
 #include "container/CallMap.hpp"
+#include "container/OodTransactionMap.hpp"
 #include "container/RtpSinkMap.hpp"
 #include "container/SbaEventMap.hpp"
 #include "container/CallDecodeQueue.hpp"
 #include "container/PcmAudioQueue.hpp"
 #include "container/SbaIncidentMap.hpp"
 #include "audio/AudioHandler.hpp"
+#include "audio/AudioDecoderFactory.hpp"
+#include "audio/MemChunkPool.hpp"
+#include "sip/SipProcessor.hpp"
 
 using namespace std;
 
@@ -59,12 +66,18 @@ CommandServer::CommandServer() {
     m_pcapPacketQueue = PcapPacketQueue::getInstance();
     m_udpPacketQueue = UdpPacketQueue::getInstance();
     m_sipPacketQueue = SipPacketQueue::getInstance();
+    m_sipPacketRepository = SipPacketRepository::getInstance();
+    m_timeoutWheel = TimeoutWheel::getInstance();
+    m_internPool = InternPool::getInstance();
     m_callMap = CallMap::getInstance();
+    m_oodTransactionMap = OodTransactionMap::getInstance();
     m_rtpSinkMap = RtpSinkMap::getInstance();
     m_sbaEventMap = SbaEventMap::getInstance();
     m_callDecodeQueue = CallDecodeQueue::getInstance();
     m_pcmAudioQueue = PcmAudioQueue::getInstance();
     m_sbaIncidentMap = SbaIncidentMap::getInstance();
+    m_audioDecoderFactory = AudioDecoderFactory::getInstance();
+    m_memChunkPool = MemChunkPool::getInstance();
 }
 
 CommandServer::~CommandServer() {
@@ -82,6 +95,7 @@ string CommandServer::prompt() const {
 
 string CommandServer::listContainer() const {
     stringstream sstream;
+    RtpStreamStats rtpStreamStats = AudioHandler::getRtpStreamStats();
     sstream << "\r\n"
             << "TlayerPacketQueue\t(cur / max): "
             << m_tlayerPacketQueue->size()
@@ -107,12 +121,36 @@ string CommandServer::listContainer() const {
             << m_sipPacketQueue->sizeMax()
             << "\r\n"
 
+            << "SipPacketRepository\t(cur / max): "
+            << m_sipPacketRepository->size()
+            << " / "
+            << m_sipPacketRepository->sizeMax()
+            << "\r\n"
+
             << "CallMap\t\t\t(cur / max): "
             << m_callMap->size()
             << " / "
             << m_callMap->sizeMax()
             << "\r\n"
 
+            << "OodTransactionMap\t(cur / max): "
+            << m_oodTransactionMap->size()
+            << " / "
+            << m_oodTransactionMap->sizeMax()
+            << "\r\n"
+
+            << "TimeoutWheel\t\t(cur / max): "
+            << m_timeoutWheel->size()
+            << " / "
+            << m_timeoutWheel->sizeMax()
+            << "\r\n"
+
+            << "InternPool\t\t(strings / bytes): "
+            << m_internPool->size()
+            << " / "
+            << m_internPool->bytes()
+            << "\r\n"
+
             << "CallDecodeQueue\t\t(cur / max): "
             << m_callDecodeQueue->size()
             << " / "
@@ -143,24 +181,92 @@ string CommandServer::listContainer() const {
             << m_sbaIncidentMap->sizeMax()
             << "\r\n"
 
+            << "AudioDecoders\t\t(created / pooled): "
+            << m_audioDecoderFactory->created()
+            << " / "
+            << m_audioDecoderFactory->pooled()
+            << "\r\n"
+
+            << "MemChunkPool\t\t(in use / pooled): "
+            << m_memChunkPool->inUse()
+            << " / "
+            << m_memChunkPool->pooled()
+            << "\r\n"
+
             << "RtpSeqNumError: "
-            << AudioHandler::rtpSeqNumError
+            << AudioHandler::rtpSeqNumError.load()
+            << "\r\n"
+
+            << "VAD silence removed [ms]: "
+            << AudioHandler::silenceRemovedMs.load()
+            << "\r\n"
+
+            << "RtpStreams\t\t(lost / reordered / duplicates / late): "
+            << rtpStreamStats.lost
+            << " / "
+            << rtpStreamStats.reordered
+            << " / "
+            << rtpStreamStats.duplicates
+            << " / "
+            << rtpStreamStats.late
+            << "\r\n"
+
+            << "RtpSources\t\t(SSRC changes / discarded): "
+            << rtpStreamStats.ssrcChanges
+            << " / "
+            << rtpStreamStats.discarded
+            << "\r\n"
+
+            << "SipRetransmissions: "
+            << SipProcessor::sipRetransmissionCount
             << "\r\n"
 
             << "\r\n";
     return sstream.str();
 }
 
-std::string CommandServer::listCallMap() const {
-    return m_callMap->toString();
+std::string CommandServer::listCallMap(const ListOptions& options) const {
+    return m_callMap->toString(options);
 }
 
-std::string CommandServer::listSbaEventMap() const {
-    return m_sbaEventMap->toString();
+std::string CommandServer::listSbaEventMap(const ListOptions& options) const {
+    return m_sbaEventMap->toString(options);
 }
 
-std::string CommandServer::listSbaIncidentMap() const {
-    return m_sbaIncidentMap->toString();
+std::string CommandServer::listSbaIncidentMap(
+        const ListOptions& options) const {
+    return m_sbaIncidentMap->toString(options);
+}
+
+bool CommandServer::parseListOptions(const std::string& args,
+        ListOptions& options) {
+    stringstream argStream(args);
+    string arg;
+    while (argStream >> arg) {
+        size_t pos = arg.find('=');
+        if (pos == string::npos)
+            return false;
+        string name = arg.substr(0, pos);
+        string value = arg.substr(pos + 1);
+
+        if (name == "filter" || name == "f") {
+            options.filter = value;
+            continue;
+        }
+
+        char* end;
+        unsigned long number = strtoul(value.c_str(), &end, 10);
+        if (value.empty() || *end != '\0')
+            return false;
+        if (name == "offset" || name == "o") {
+            options.offset = number;
+        } else if ((name == "limit" || name == "n") && number > 0) {
+            options.limit = number;
+        } else {
+            return false;
+        }
+    }
+    return true;
 }
 
 std::string CommandServer::clearSba() const {
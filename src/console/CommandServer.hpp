@@ -31,17 +31,25 @@
 #ifndef COMMANDSERVER_HPP_
 #define COMMANDSERVER_HPP_
 
+#include "container/ListOptions.hpp"
+
 namespace callx {
 
 class PcapPacketQueue;
 class UdpPacketQueue;
 class SipPacketQueue;
+class SipPacketRepository;
+class TimeoutWheel;
+class InternPool;
 class CallMap;
+class OodTransactionMap;
 class RtpSinkMap;
 class SbaEventMap;
 class CallDecodeQueue;
 class PcmAudioQueue;
 class SbaIncidentMap;
+class AudioDecoderFactory;
+class MemChunkPool;
 class TlayerPacketQueue;
 
 class CommandServer {
@@ -52,9 +60,19 @@ public:
     std::string welcome() const;
     std::string prompt() const;
     std::string listContainer() const;
-    std::string listCallMap() const;
-    std::string listSbaEventMap() const;
-    std::string listSbaIncidentMap() const;
+    std::string listCallMap(const ListOptions& options) const;
+    std::string listSbaEventMap(const ListOptions& options) const;
+    std::string listSbaIncidentMap(const ListOptions& options) const;
+
+    /**
+     * Parses the arguments of a list command: [filter=<Call-ID or caller>]
+     * [offset=<n>] [limit=<n>].
+     * @param args Arguments, separated by whitespace.
+     * @param options
+     * @return False, if an argument is invalid.
+     */
+    static bool parseListOptions(const std::string& args,
+            ListOptions& options);
     std::string clearSba() const;
 
     static const std::string welcomeStr;
@@ -64,12 +82,18 @@ private:
     PcapPacketQueue *m_pcapPacketQueue;
     UdpPacketQueue *m_udpPacketQueue;
     SipPacketQueue *m_sipPacketQueue;
+    SipPacketRepository *m_sipPacketRepository;
+    TimeoutWheel *m_timeoutWheel;
+    InternPool *m_internPool;
     CallMap *m_callMap;
+    OodTransactionMap *m_oodTransactionMap;
     RtpSinkMap *m_rtpSinkMap;
     SbaEventMap *m_sbaEventMap;
     CallDecodeQueue *m_callDecodeQueue;
     PcmAudioQueue *m_pcmAudioQueue;
     SbaIncidentMap *m_sbaIncidentMap;
+    AudioDecoderFactory *m_audioDecoderFactory;
+    MemChunkPool *m_memChunkPool;
     TlayerPacketQueue *m_tlayerPacketQueue;
 };
 
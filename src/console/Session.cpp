@@ -80,17 +80,32 @@ void Session::handle_read(const boost::system::error_code& error,
             L_t
                     << "m_userData: "
                     << m_userData;
-            if (m_userData == "status" || m_userData == "s") {
+
+            // The list commands take arguments (see help).
+            string command = m_userData.substr(0, m_userData.find(' '));
+            string args;
+            if (command.size() < m_userData.size())
+                args = m_userData.substr(command.size() + 1);
+            ListOptions options;
+            bool isListCommand = command == "CallMap" || command == "c"
+                    || command == "SbaEventMap" || command == "e"
+                    || command == "SbaIncidentMap" || command == "i";
+
+            if (isListCommand
+                    && !CommandServer::parseListOptions(args, options)) {
+                m_output << "invalid arguments, see help\r\n";
+                m_userData = "";
+            } else if (m_userData == "status" || m_userData == "s") {
                 m_output << m_cmdSrv.listContainer();
                 m_userData = "";
-            } else if (m_userData == "CallMap" || m_userData == "c") {
-                m_output << m_cmdSrv.listCallMap();
+            } else if (command == "CallMap" || command == "c") {
+                m_output << m_cmdSrv.listCallMap(options);
                 m_userData = "";
-            } else if (m_userData == "SbaEventMap" || m_userData == "e") {
-                m_output << m_cmdSrv.listSbaEventMap();
+            } else if (command == "SbaEventMap" || command == "e") {
+                m_output << m_cmdSrv.listSbaEventMap(options);
                 m_userData = "";
-            } else if (m_userData == "SbaIncidentMap" || m_userData == "i") {
-                m_output << m_cmdSrv.listSbaIncidentMap();
+            } else if (command == "SbaIncidentMap" || command == "i") {
+                m_output << m_cmdSrv.listSbaIncidentMap(options);
                 m_userData = "";
             } else if (m_userData == "ClearSba" || m_userData == "l") {
                 m_output << m_cmdSrv.clearSba();
@@ -106,12 +121,20 @@ void Session::handle_read(const boost::system::error_code& error,
                 m_output << "\r\nList of commands. Shortcuts in brackets. "
                         << "Commands are case sensitive.\r\n"
                         << "(s) status\r\n"
-                        << "(c) CallMap\r\n"
-                        << "(e) SbaEventMap\r\n"
-                        << "(i) SbaIncidentMap\r\n"
+                        << "(c) CallMap [options]\r\n"
+                        << "(e) SbaEventMap [options]\r\n"
+                        << "(i) SbaIncidentMap [options]\r\n"
                         << "(l) ClearSba\r\n"
                         << "(q) quit (console)\r\n"
                         << "(t) terminate (program)\r\n"
+                        << "\r\n"
+                        << "Options of the list commands (c, e, i):\r\n"
+                        << "(f) filter=<Call-ID or caller, substring>\r\n"
+                        << "(o) offset=<first entry, default 0>\r\n"
+                        << "(n) limit=<entries per page, default "
+                        << ListOptions::Default_Limit
+                        << ">\r\n"
+                        << "e.g. c f=alice@example.org o=100 n=50\r\n"
                         << "\r\n";
                 m_userData = "";
 
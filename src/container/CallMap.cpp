@@ -30,7 +30,10 @@
 
 #include "CallMap.hpp"
 #include "CallDecodeQueue.hpp"
+#include "InternPool.hpp"
 #include "config/CallxConfig.hpp"
+#include "sip/Transaction.hpp"
+#include <algorithm>
 #include <deque>
 
 using namespace std;
@@ -38,8 +41,10 @@ using namespace std;
 namespace callx {
 
 CallMap::CallMap()
-        : m_callxConfig(CallxConfig::getInstance()),
-          m_callDecodeQueue(CallDecodeQueue::getInstance()) {
+        : ShardedHashMap(CallxConfig::getInstance()->call_map_shards),
+          m_callxConfig(CallxConfig::getInstance()),
+          m_callDecodeQueue(CallDecodeQueue::getInstance()),
+          m_timeoutWheel(TimeoutWheel::getInstance()) {
     L_t
     << "C'tor";
 }
@@ -49,24 +54,54 @@ CallMap::~CallMap() {
     << "D'tor";
 }
 
-string CallMap::toString() const {
+string CallMap::toString(const ListOptions& options) const {
+    InternPool *internPool = InternPool::getInstance();
+
+    // Copy the Call pointers, one shard at a time.
+    vector<shared_ptr<Call>> calls;
+    calls.reserve(size());
+    for (size_t shard = 0; shard < m_shards.size(); shard++) {
+        copyShard(shard, calls);
+    }
+
+    // Select the matching calls.
+    vector<shared_ptr<Call>> matches;
+    for (auto iter = calls.begin(); iter != calls.end(); iter++) {
+        shared_ptr<Dialog> dialog = (*iter)->getDialog();
+        if (options.matches(dialog->callId)
+                || options.matches(internPool->lookup(dialog->caller.address))
+                || options.matches(internPool->lookup(dialog->callee.address)))
+            matches.push_back(*iter);
+    }
+    sort(matches.begin(), matches.end(),
+            [](const shared_ptr<Call>& a, const shared_ptr<Call>& b) {
+                return a->getCreationTsSteadyClock()
+                        < b->getCreationTsSteadyClock();
+            });
+
+    if (matches.empty()) {
+        return options.filter.empty() ?
+                "\r\nCallMap is empty.\r\n\r\n" :
+                "\r\nNo matching call.\r\n\r\n";
+    }
+
     stringstream strstream;
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto iter = m_map.begin(); iter != m_map.end(); iter++) {
+    strstream << options.header("Calls", matches.size());
+    for (size_t i = options.offset;
+            i < matches.size() && options.inPage(i); i++) {
+        shared_ptr<Dialog> dialog = matches[i]->getDialog();
         strstream << "\r\n"
                   << "Call ID: "
-                  << iter->second->getDialog()->callId
+                  << dialog->callId
                   << "\r\n"
                   << "From: "
-                  << iter->second->getDialog()->caller.address
+                  << internPool->lookup(dialog->caller.address)
                   << "\r\n"
                   << "To: "
-                  << iter->second->getDialog()->callee.address
-                  << "\r\n\r\n";
-    }
-    if (strstream.tellp() == 0) {
-        strstream << "\r\n" << "CallMap is empty.\r\n\r\n";
+                  << internPool->lookup(dialog->callee.address)
+                  << "\r\n";
     }
+    strstream << "\r\n";
     return strstream.str();
 }
 
@@ -75,87 +110,66 @@ void CallMap::handleCallTimeouts() {
 // Temporary queue of calls that will be moved into CallDecodeQueue.
     std::deque<std::shared_ptr<Call> > tempCallQueue;
 
-//    auto max_age = boost::chrono::seconds(m_callxConfig->max_call_age);
-//    auto max_rtp_inactivity = boost::chrono::seconds(
-//            m_callxConfig->max_call_rtp_inactivity);
+// Temporary queue of calls whose audio will be copied into CallDecodeQueue.
+    std::deque<std::shared_ptr<Call> > tempReleaseQueue;
 
-// making a snapshot of the map
-    std::unique_lock<std::mutex> callMapLock(m_mutex);
-    map<string, shared_ptr<Call>> mapSnapShot(m_map);
-    callMapLock.unlock();
+    auto now = steadyClock::now();
 
-    for (auto callIter = mapSnapShot.begin(); callIter != mapSnapShot.end();
-            callIter++) {
+// Only the calls and transactions with an expired TimeoutWheel entry are
+// visited.
+    m_expired.clear();
+    m_timeoutWheel->advance(now, m_expired);
 
-        auto now = boost::chrono::steady_clock::now();
-        auto currCall = callIter->second;
-        auto callLock = currCall->getUniqueLock();
+    for (auto entryIter = m_expired.begin(); entryIter != m_expired.end();
+            entryIter++) {
 
-        //////////////////////////////////////////
-        // START handle max_call_recording_time //
-        //--------------------------------------//
-
-        // Deactivate RtpSink objects, if max recording time is exceeded.
-        currCall->checkRecordingTime(m_callxConfig->max_call_recording_time);
-
-        //--------------------------------------//
-        // START handle max_call_recording_time //
-        //////////////////////////////////////////
-
-        //////////////////////////////////////////
-        // START handle max_call_rtp_inactivity //
-        //--------------------------------------//
-        // Push Call into CallDecodeQueue in case of RTP inactivity.
-        int rtpInactivity = currCall->getRtpInactivityTime();
-//        L_t
-//        << "RTP inactivity: " << rtpInactivity;
-        if (rtpInactivity > m_callxConfig->max_call_rtp_inactivity) {
-            L_t
-            << "RTP inactivity of " << rtpInactivity << " seconds exceeds the limit.";
-            // max_call_rtp_inactivity exceeded!
-            // This call will be deleted from global CallMap and pushed
-            // to the CallDecodeQueue.
-            currCall->unregisterRtpSinks();
-            tempCallQueue.push_back(currCall);
+        // The Call object may be gone already.
+        auto currCall = entryIter->call.lock();
+        if (!currCall) {
+            continue;
         }
-        //--------------------------------------//
-        // END handle max_call_rtp_inactivity   //
-        //////////////////////////////////////////
 
-        //////////////////////////////////////////
-        // START handle max_call_age            //
-        //--------------------------------------//
+        if (entryIter->type == to_TRANSACTION) {
+
+            // The transaction may have been deleted by the SipProcessor.
+            auto currTransaction = entryIter->transaction.lock();
+            if (currTransaction) {
+                auto callLock = currCall->getUniqueLock();
+                handleTransactionTimeout(currCall, currTransaction, now);
+            }
+            continue;
+        }
 
-        // Push Call into CallDecodeQueue if it exceeds max_call_age.
-        int callAge = (boost::chrono::duration_cast<seconds>(
-                now - currCall->getCreationTsSteadyClock()).count());
+        // Calls which have already left the CallMap are not checked and
+        // not rescheduled any more.
+        std::shared_ptr<Call> mappedCall;
+        if (!find(currCall->getDialog()->callId, mappedCall)
+                || mappedCall != currCall) {
+            continue;
+        }
 
-//        L_t
-//        << "Call age: " << callAge;
-        if (callAge > m_callxConfig->max_call_age) {
-            L_t
-            << "Call to old: " << callAge;
+        auto callLock = currCall->getUniqueLock();
+        if (handleCallTimeout(currCall, now)) {
 
-            // max_call_age exceeded!
             // This call will be deleted from global CallMap and pushed
             // to the CallDecodeQueue.
             currCall->unregisterRtpSinks();
             tempCallQueue.push_back(currCall);
-        }
-        //--------------------------------------//
-        // END handle max_call_age              //
-        //////////////////////////////////////////
+        } else if (handleCaptureBudget(currCall)) {
 
+            // The audio is decoded now, the call stays in the CallMap for
+            // the signaling.
+            tempReleaseQueue.push_back(currCall);
+        }
         callLock->unlock();
     }
+    m_expired.clear();
 
 // All Call object references of the tempCallQueue will be deleted
 // from global CallMap and pushed to the CallDecodeQueue now.
-
-    callMapLock.lock(); // lock the lock again because we want to change m_map;
     for (auto callIter = tempCallQueue.begin(); callIter != tempCallQueue.end();
             callIter++) {
-        if (m_map.erase((*callIter)->getDialog()->callId)) {
+        if (erase((*callIter)->getDialog()->callId)) {
             L_t
             << "Erased one reference from CallMap.";
             m_callDecodeQueue->push(move(*callIter));
@@ -163,6 +177,144 @@ void CallMap::handleCallTimeouts() {
             << "Pushed one reference to the CallDecodeQueue.";
         }
     }
+    for (auto callIter = tempReleaseQueue.begin();
+            callIter != tempReleaseQueue.end(); callIter++) {
+        m_callDecodeQueue->push(move(*callIter));
+        L_t
+        << "Pushed one released reference to the CallDecodeQueue.";
+    }
+}
+
+bool CallMap::handleCallTimeout(const std::shared_ptr<Call>& currCall,
+        const steadyClock::time_point& now) {
+
+    //////////////////////////////////////////
+    // START handle max_call_recording_time //
+    //--------------------------------------//
+
+    // Deactivate RtpSink objects, if max recording time is exceeded.
+    currCall->checkRecordingTime(m_callxConfig->max_call_recording_time);
+
+    //--------------------------------------//
+    // END handle max_call_recording_time   //
+    //////////////////////////////////////////
+
+    //////////////////////////////////////////
+    // START handle max_call_rtp_inactivity //
+    //--------------------------------------//
+
+    // Push Call into CallDecodeQueue in case of RTP inactivity.
+    int rtpInactivity = currCall->getRtpInactivityTime();
+    if (rtpInactivity > m_callxConfig->max_call_rtp_inactivity) {
+        L_t
+        << "RTP inactivity of " << rtpInactivity << " seconds exceeds the limit.";
+        return true;
+    }
+
+    //--------------------------------------//
+    // END handle max_call_rtp_inactivity   //
+    //////////////////////////////////////////
+
+    //////////////////////////////////////////
+    // START handle max_call_age            //
+    //--------------------------------------//
+
+    // Push Call into CallDecodeQueue if it exceeds max_call_age.
+    int callAge = (boost::chrono::duration_cast<seconds>(
+            now - currCall->getCreationTsSteadyClock()).count());
+    if (callAge > m_callxConfig->max_call_age) {
+        L_t
+        << "Call to old: " << callAge;
+        return true;
+    }
+
+    //--------------------------------------//
+    // END handle max_call_age              //
+    //////////////////////////////////////////
+
+    // No limit exceeded, check again at the next deadline.
+    scheduleCallTimeouts(currCall);
+    return false;
+}
+
+bool CallMap::handleCaptureBudget(const std::shared_ptr<Call>& call) {
+    if (!m_callxConfig->capture_budget_seconds || !call->rtpSinksAreActivated()
+            || call->getRtpSinkMap()->empty()) {
+        return false;
+    }
+
+    int capturedSeconds = call->getCapturedSeconds();
+    if (capturedSeconds < m_callxConfig->capture_budget_seconds) {
+        return false;
+    }
+
+    L_t
+    << "Capture budget met after " << capturedSeconds << " seconds.";
+    call->releaseAudio();
+    return true;
+}
+
+void CallMap::scheduleCallTimeouts(const std::shared_ptr<Call>& call) {
+
+    // The limits are checked with "greater than" in whole seconds, so a
+    // deadline is one second after the limit.
+    auto now = steadyClock::now();
+    auto created = call->getCreationTsSteadyClock();
+
+    // max_call_age
+    steadyClock::time_point deadline = created
+            + seconds(m_callxConfig->max_call_age + 1);
+
+    // max_call_recording_time, if not yet deactivated
+    if (call->rtpSinksAreActivated()) {
+        deadline = std::min(deadline,
+                created + seconds(m_callxConfig->max_call_recording_time + 1));
+    }
+
+    // max_call_rtp_inactivity, from the current inactivity on
+    int remaining = m_callxConfig->max_call_rtp_inactivity
+            - call->getRtpInactivityTime();
+    deadline = std::min(deadline, now + seconds(std::max(remaining, 0) + 1));
+
+    // capture_budget_seconds, from the audio captured so far on
+    if (m_callxConfig->capture_budget_seconds && call->rtpSinksAreActivated()) {
+        int missing = m_callxConfig->capture_budget_seconds
+                - call->getCapturedSeconds();
+        deadline = std::min(deadline, now + seconds(std::max(missing, 0) + 1));
+    }
+
+    TimeoutEntry entry = { to_CALL, call, std::weak_ptr<Transaction>() };
+    m_timeoutWheel->schedule(deadline, move(entry));
+}
+
+void CallMap::scheduleTransactionTimeout(const std::shared_ptr<Call>& call,
+        const std::shared_ptr<Transaction>& transaction) {
+    TimeoutEntry entry = { to_TRANSACTION, call, transaction };
+    m_timeoutWheel->schedule(
+            transaction->getActivityClockstamp()
+                    + seconds(m_callxConfig->max_transaction_inactivity),
+            move(entry));
+}
+
+void CallMap::handleTransactionTimeout(const std::shared_ptr<Call>& call,
+        const std::shared_ptr<Transaction>& transaction,
+        const steadyClock::time_point& now) {
+
+    // The transaction has been active since its check was scheduled.
+    if (now - transaction->getActivityClockstamp()
+            < seconds(m_callxConfig->max_transaction_inactivity)) {
+        scheduleTransactionTimeout(call, transaction);
+        return;
+    }
+
+    // Delete it, if the call still owns this very transaction.
+    if (call->delTransaction(transaction)) {
+        L_i
+        << "Transaction expired without final response. Call ID: "
+        << call->getDialog()->callId
+        << ", method: "
+        << requestMethodEnumToString(transaction->getCseqMethod());
+    }
 }
 
 } /* namespace callx */
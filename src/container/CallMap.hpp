@@ -31,7 +31,9 @@
 #ifndef CALLMAP_HPP_
 #define CALLMAP_HPP_
 
-#include "ThreadFriendlyMap.hpp"
+#include "ShardedHashMap.hpp"
+#include "TimeoutWheel.hpp"
+#include "ListOptions.hpp"
 #include "main/CallxSingleton.hpp"
 #include "sip/Call.hpp"
 
@@ -39,9 +41,10 @@ namespace callx {
 
 class CallDecodeQueue;
 class CallxConfig;
+class Transaction;
 
 class CallMap:
-        public ThreadFriendlyMap<std::string, std::shared_ptr<Call> >,
+        public ShardedHashMap<std::shared_ptr<Call> >,
         public CallxSingleton<CallMap> {
 
     friend class CallxSingleton<CallMap> ;
@@ -54,10 +57,12 @@ public:
     virtual ~CallMap();
 
     /**
-     * String representation.
+     * String representation of a page of calls, oldest first. The shard
+     * locks are only held to copy the Call pointers.
+     * @param options Filter (Call-ID, caller or callee), offset and limit.
      * @return string
      */
-    std::string toString() const;
+    std::string toString(const ListOptions& options) const;
 
     /**
     * Check and handle exceeding of the following timers (config values):
@@ -72,9 +77,36 @@ public:
     * max_call_rtp_inactivity:
     *   The call will be taken out of the CallMap and put into the
     *   CallDecodeQueue.
+    *
+    * capture_budget_seconds:
+    *   All RtpSinks of the call will be deactivated and the call will be
+    *   put into the CallDecodeQueue, but stays in the CallMap.
+    *
+    * max_transaction_inactivity:
+    *   The transaction will be deleted from its call.
+    *
+    * Only calls and transactions whose TimeoutWheel entry expires are
+    * visited.
     */
     void handleCallTimeouts();
 
+    /**
+     * Schedules the next timeout check of a call, the earliest of
+     * max_call_age, max_call_recording_time, max_call_rtp_inactivity and
+     * the expected end of the capture budget.
+     * The caller has to hold the lock of the call.
+     * @param call
+     */
+    void scheduleCallTimeouts(const std::shared_ptr<Call>& call);
+
+    /**
+     * Schedules the max_transaction_inactivity check of a transaction.
+     * @param call The call owning the transaction.
+     * @param transaction
+     */
+    void scheduleTransactionTimeout(const std::shared_ptr<Call>& call,
+            const std::shared_ptr<Transaction>& transaction);
+
 private:
 
     /**
@@ -82,8 +114,34 @@ private:
      */
     CallMap();
 
+    /**
+     * Handles the expired check of a call.
+     * @return True if the call has to be decoded now.
+     */
+    bool handleCallTimeout(const std::shared_ptr<Call>& call,
+            const steadyClock::time_point& now);
+
+    /**
+     * Releases the audio of a call whose RtpSinks all have captured
+     * capture_budget_seconds. The caller has to hold the lock of the call.
+     * @return True if the call has to be decoded now.
+     */
+    bool handleCaptureBudget(const std::shared_ptr<Call>& call);
+
+    /**
+     * Handles the expired check of a transaction. The caller has to hold
+     * the lock of the call.
+     */
+    void handleTransactionTimeout(const std::shared_ptr<Call>& call,
+            const std::shared_ptr<Transaction>& transaction,
+            const steadyClock::time_point& now);
+
     CallxConfig *m_callxConfig;
     CallDecodeQueue *m_callDecodeQueue;
+    TimeoutWheel *m_timeoutWheel;
+
+    // expired entries of the current handleCallTimeouts() run
+    std::vector<TimeoutEntry> m_expired;
 };
 
 } /* namespace callx */
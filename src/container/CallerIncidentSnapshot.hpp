@@ -0,0 +1,128 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * CallerIncidentSnapshot.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef CALLERINCIDENTSNAPSHOT_HPP_
+#define CALLERINCIDENTSNAPSHOT_HPP_
+
+#include <vector>
+#include <stdint.h>
+#include <boost/unordered_set.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "ShardedHashMap.hpp"
+#include "InternPool.hpp"
+
+namespace callx {
+
+/**
+ * Immutable set of the callers with at least one incident, as of the end
+ * of an SBA run. A Bloom filter in front of the hash set answers most
+ * probes of unflagged callers with a few bit tests. The caller strings
+ * are not copied, the snapshot holds their InternIds instead.
+ */
+class CallerIncidentSnapshot {
+public:
+
+    CallerIncidentSnapshot(const std::vector<InternId>& callers)
+            : m_ids(callers),
+              m_bloomMask(0) {
+        InternPool *internPool = InternPool::getInstance();
+
+        // about 10 bits per caller, 64 bits at least
+        size_t bits = 64;
+        while (bits < callers.size() * Bits_Per_Caller)
+            bits <<= 1;
+        m_bloom.assign(bits / 64, 0);
+        m_bloomMask = bits - 1;
+
+        m_callers.reserve(callers.size());
+        for (auto iter = m_ids.begin(); iter != m_ids.end(); iter++) {
+            boost::string_ref caller = internPool->lookup(*iter);
+            size_t hash = StringRefHash()(caller);
+            for (int i = 0; i < Hash_Count; i++) {
+                size_t bit = bloomBit(hash, i);
+                m_bloom[bit / 64] |= uint64_t(1) << (bit % 64);
+            }
+            m_callers.insert(caller);
+        }
+    }
+
+    /**
+     * @param caller Caller address, eg. sip:blah@blubb
+     * @return True, if the caller is flagged.
+     */
+    bool contains(boost::string_ref caller) const {
+        if (m_callers.empty())
+            return false;
+
+        size_t hash = StringRefHash()(caller);
+        for (int i = 0; i < Hash_Count; i++) {
+            size_t bit = bloomBit(hash, i);
+            if (!(m_bloom[bit / 64] & (uint64_t(1) << (bit % 64))))
+                return false;
+        }
+        return m_callers.find(caller, PrecomputedHash(hash),
+                std::equal_to<boost::string_ref>()) != m_callers.end();
+    }
+
+    size_t size() const {
+        return m_callers.size();
+    }
+
+private:
+
+    static const int Hash_Count = 4;
+    static const size_t Bits_Per_Caller = 10;
+
+    struct PrecomputedHash {
+        PrecomputedHash(size_t hash)
+                : hash(hash) {
+        }
+        size_t operator()(boost::string_ref) const {
+            return hash;
+        }
+        size_t hash;
+    };
+
+    // i-th Bloom filter bit of a hash (double hashing)
+    size_t bloomBit(size_t hash, int i) const {
+        size_t step = (hash >> 16) | 1;
+        return (hash + i * step) & m_bloomMask;
+    }
+
+    // keep the caller strings in the InternPool
+    std::vector<InternId> m_ids;
+
+    std::vector<uint64_t> m_bloom;
+    size_t m_bloomMask;
+    boost::unordered_set<boost::string_ref, StringRefHash> m_callers;
+};
+
+} /* namespace callx */
+
+#endif /* CALLERINCIDENTSNAPSHOT_HPP_ */
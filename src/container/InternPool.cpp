@@ -0,0 +1,200 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * InternPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "InternPool.hpp"
+#include <algorithm>
+
+using namespace std;
+
+namespace callx {
+
+InternPool::InternPool()
+        : m_chunks(Max_Chunks, nullptr),
+          m_chunkCount(1),
+          m_chunkOffset(0),
+          m_freeEntries(Chunk_Size / Entry_Align + 1),
+          m_fullLogged(false) {
+    L_t
+    << "C'tor";
+
+    // ID 0 is the empty string, it is never released
+    m_chunks[0] = new char[Chunk_Size];
+    append(boost::string_ref());
+}
+
+InternPool::~InternPool() {
+    L_t
+    << "D'tor";
+    for (size_t i = 0; i < m_chunkCount; i++) {
+        delete[] m_chunks[i];
+    }
+
+    // InternIds destroyed later must not touch the arena
+    m_instance = nullptr;
+}
+
+InternId InternPool::intern(boost::string_ref str) {
+    if (str.empty())
+        return InternId();
+    if (str.size() > Max_Length)
+        str = str.substr(0, Max_Length);
+
+    lock_guard lock(m_mutex);
+    auto iter = m_index.find(str);
+    if (iter != m_index.end()) {
+        entry(iter->second)->refCount++;
+        return InternId(iter->second);
+    }
+
+    uint32_t id = append(str);
+    if (id) {
+        m_index.insert( { entryString(id), id });
+    }
+    return InternId(id);
+}
+
+SipIdentity InternPool::intern(const SipFromTo& fromTo) {
+    SipIdentity identity;
+    identity.tag = fromTo.tag;
+    identity.address = intern(fromTo.address);
+    identity.displayname = intern(fromTo.displayname);
+    return identity;
+}
+
+bool InternPool::find(boost::string_ref str, InternId& id) const {
+    if (str.empty()) {
+        id = InternId();
+        return true;
+    }
+
+    lock_guard lock(m_mutex);
+    auto iter = m_index.find(str);
+    if (iter == m_index.end())
+        return false;
+    entry(iter->second)->refCount++;
+    id = InternId(iter->second);
+    return true;
+}
+
+void InternPool::retain(uint32_t id) {
+    if (id && m_instance) {
+        m_instance->entry(id)->refCount++;
+    }
+}
+
+void InternPool::release(uint32_t id) {
+    if (id && m_instance && --m_instance->entry(id)->refCount == 0) {
+        m_instance->free(id);
+    }
+}
+
+size_t InternPool::size() const {
+    lock_guard lock(m_mutex);
+    return m_index.size();
+}
+
+size_t InternPool::bytes() const {
+    lock_guard lock(m_mutex);
+    return (m_chunkCount - 1) * Chunk_Size + m_chunkOffset;
+}
+
+uint32_t InternPool::append(boost::string_ref str) {
+    size_t entrySize = (Header_Size + str.size() + Entry_Align)
+            / Entry_Align * Entry_Align;
+    vector<uint32_t>& freeEntries = m_freeEntries[entrySize / Entry_Align];
+
+    uint32_t id;
+    if (!freeEntries.empty()) {
+
+        // reuse an entry of the same size
+        id = freeEntries.back();
+        freeEntries.pop_back();
+    } else {
+
+        // start a new chunk, if the entry does not fit
+        if (m_chunkOffset + entrySize > Chunk_Size) {
+            if (m_chunkCount == Max_Chunks) {
+                if (!m_fullLogged) {
+                    L_e
+                    << "InternPool error: arena is full, new strings are "
+                    << "not interned.";
+                    m_fullLogged = true;
+                }
+                return 0;
+            }
+            m_chunks[m_chunkCount++] = new char[Chunk_Size];
+            m_chunkOffset = 0;
+        }
+        id = (m_chunkCount - 1) * Chunk_Size + m_chunkOffset;
+        m_chunkOffset += entrySize;
+    }
+
+    Entry* newEntry = entry(id);
+    newEntry->refCount = 1;
+    newEntry->length = str.size();
+    newEntry->used = true;
+    char* data = reinterpret_cast<char*>(newEntry) + Header_Size;
+    copy(str.begin(), str.end(), data);
+    data[str.size()] = '\0';
+    return id;
+}
+
+void InternPool::free(uint32_t id) {
+    lock_guard lock(m_mutex);
+
+    // intern() may have handed out the string again meanwhile, or another
+    // release() may have freed it already
+    Entry* oldEntry = entry(id);
+    if (!oldEntry->used || oldEntry->refCount != 0)
+        return;
+
+    m_index.erase(entryString(id));
+    oldEntry->used = false;
+    size_t entrySize = (Header_Size + oldEntry->length + Entry_Align)
+            / Entry_Align * Entry_Align;
+    m_freeEntries[entrySize / Entry_Align].push_back(id);
+}
+
+InternId::InternId(const InternId& other)
+        : m_id(other.m_id) {
+    InternPool::retain(m_id);
+}
+
+InternId& InternId::operator=(const InternId& other) {
+    InternPool::retain(other.m_id);
+    InternPool::release(m_id);
+    m_id = other.m_id;
+    return *this;
+}
+
+InternId::~InternId() {
+    InternPool::release(m_id);
+}
+
+} /* namespace callx */
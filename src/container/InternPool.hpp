@@ -0,0 +1,174 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * InternPool.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INTERNPOOL_HPP_
+#define INTERNPOOL_HPP_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "ShardedHashMap.hpp"
+#include "main/CallxSingleton.hpp"
+#include "main/CallxTypes.hpp"
+#include "main/callx.hpp"
+
+namespace callx {
+
+/**
+ * Pool of interned strings (SIP addresses and display names). Every
+ * distinct string is stored once in an arena of fixed-size chunks and is
+ * identified by a compact InternId, the position of the string in the
+ * arena. Chunks are never moved or freed, so resolving an ID needs no
+ * lock. Interning is thread-safe.
+ *
+ * Every entry counts the InternIds referring to it. An entry without
+ * references leaves the index and its space is reused for a string of
+ * the same size class, so the arena is bounded by the strings in use,
+ * not by all strings ever seen. If the arena is full nevertheless, new
+ * strings are not interned and resolve to the empty string.
+ */
+class InternPool:
+        public CallxSingleton<InternPool> {
+
+    friend class CallxSingleton<InternPool> ;
+
+public:
+
+    // arena chunk size
+    static const size_t Chunk_Size = 1 << 16;
+
+    // max. number of arena chunks (1 GiB arena)
+    static const size_t Max_Chunks = 1 << 14;
+
+    // max. length of an interned string
+    static const size_t Max_Length = Chunk_Size - 32;
+
+    /**
+     * Destructor
+     */
+    virtual ~InternPool();
+
+    /**
+     * Interns a string. Strings longer than Max_Length are truncated.
+     * @param str
+     * @return ID of the string, 0 for the empty string or if the arena is
+     * full.
+     */
+    InternId intern(boost::string_ref str);
+
+    /**
+     * Interns address and display name of a SipFromTo.
+     * @param fromTo
+     * @return
+     */
+    SipIdentity intern(const SipFromTo& fromTo);
+
+    /**
+     * Searches an already interned string.
+     * @param str
+     * @param id Set to the ID of the string.
+     * @return True, if the string has been interned before.
+     */
+    bool find(boost::string_ref str, InternId& id) const;
+
+    /**
+     * Resolves an ID. The ID must have been returned by intern().
+     * @param id
+     * @return The interned string, valid as long as id refers to it.
+     */
+    boost::string_ref lookup(const InternId& id) const {
+        return entryString(id.value());
+    }
+
+    // adds and drops a reference of an InternId
+    static void retain(uint32_t id);
+    static void release(uint32_t id);
+
+    size_t size() const;
+    size_t bytes() const;
+
+private:
+
+    // entry header, the string and its '\0' follow; used is cleared when
+    // the entry is free
+    struct Entry {
+        std::atomic<uint32_t> refCount;
+        uint16_t length;
+        bool used;
+    };
+
+    // length of an entry header, entries are aligned to Entry_Align
+    static const size_t Header_Size = 8;
+    static const size_t Entry_Align = 16;
+    static_assert(sizeof(Entry) <= Header_Size,
+            "InternPool entry header too large");
+
+    /**
+     * Hidden constructor
+     */
+    InternPool();
+
+    Entry* entry(uint32_t id) const {
+        return reinterpret_cast<Entry*>(m_chunks[id / Chunk_Size]
+                + id % Chunk_Size);
+    }
+
+    boost::string_ref entryString(uint32_t id) const {
+        const Entry* entry = this->entry(id);
+        return boost::string_ref(
+                reinterpret_cast<const char*>(entry) + Header_Size,
+                entry->length);
+    }
+
+    // copies str into a free entry or the end of the arena, returns its ID
+    // or 0 if the arena is full
+    uint32_t append(boost::string_ref str);
+
+    // removes an entry without references from the index
+    void free(uint32_t id);
+
+    // chunk pointers, sized Max_Chunks once so readers never see a realloc
+    std::vector<char*> m_chunks;
+    size_t m_chunkCount;
+    size_t m_chunkOffset;
+
+    // IDs of the unused entries, by size class (entry size / Entry_Align)
+    std::vector<std::vector<uint32_t> > m_freeEntries;
+    bool m_fullLogged;
+
+    // keys point into the arena
+    boost::unordered_map<boost::string_ref, uint32_t, StringRefHash> m_index;
+    mutable mutex m_mutex;
+};
+
+} /* namespace callx */
+
+#endif /* INTERNPOOL_HPP_ */
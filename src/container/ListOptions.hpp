@@ -0,0 +1,99 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ListOptions.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef LISTOPTIONS_HPP_
+#define LISTOPTIONS_HPP_
+
+#include <string>
+#include <sstream>
+#include <boost/utility/string_ref.hpp>
+
+namespace callx {
+
+/**
+ * Paging and filtering of the console listings (CallMap, SbaEventMap,
+ * SbaIncidentMap). The containers copy the selected entries while holding
+ * their lock and format them afterwards.
+ */
+struct ListOptions {
+
+    static const size_t Default_Limit = 100;
+
+    ListOptions()
+            : offset(0),
+              limit(Default_Limit) {
+    }
+
+    /**
+     * @param value Call-ID or caller address.
+     * @return True, if the value contains the filter string.
+     */
+    bool matches(boost::string_ref value) const {
+        return filter.empty() || value.find(filter) != boost::string_ref::npos;
+    }
+
+    /**
+     * @param index Position of a matching entry.
+     * @return True, if the entry is on the requested page.
+     */
+    bool inPage(size_t index) const {
+        return index >= offset && index - offset < limit;
+    }
+
+    /**
+     * Header line of a listing, eg. "Calls 1 - 100 of 5234".
+     * @param name
+     * @param total Number of matching entries.
+     * @return
+     */
+    std::string header(const std::string& name, size_t total) const {
+        std::stringstream strstream;
+        size_t last = total;
+        if (total > offset && total - offset > limit)
+            last = offset + limit;
+        strstream << "\r\n" << name << " ";
+        if (total > offset)
+            strstream << offset + 1 << " - " << last;
+        else
+            strstream << "0";
+        strstream << " of " << total;
+        if (!filter.empty())
+            strstream << " (filter: " << filter << ")";
+        strstream << "\r\n";
+        return strstream.str();
+    }
+
+    size_t offset;
+    size_t limit;
+    std::string filter;
+};
+
+} /* namespace callx */
+
+#endif /* LISTOPTIONS_HPP_ */
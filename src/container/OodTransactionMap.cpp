@@ -0,0 +1,141 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * OodTransactionMap.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "OodTransactionMap.hpp"
+#include "config/CallxConfig.hpp"
+#include "sip/SipPacket.hpp"
+#include "InternPool.hpp"
+
+using namespace std;
+
+namespace callx {
+
+OodTransactionMap::OodTransactionMap()
+        : m_sizeMax(0),
+          m_callxConfig(CallxConfig::getInstance()) {
+    L_t
+    << "C'tor";
+}
+
+OodTransactionMap::~OodTransactionMap() {
+    L_t
+    << "D'tor";
+}
+
+string OodTransactionMap::key(const SipPacket& sipPacket) {
+    string k(sipPacket.getCallId());
+    k += '\n';
+    k += sipPacket.getBranch();
+    k += '\n';
+    k += static_cast<char>('0' + sipPacket.getCseqMethod());
+    return k;
+}
+
+bool OodTransactionMap::insert(const SipPacket& sipPacket) {
+    auto now = steadyClock::now();
+    string k = key(sipPacket);
+
+    lock_guard lock(m_mutex);
+    expire(now);
+
+    OodTransaction transaction;
+    transaction.creationTs = now;
+    transaction.callId = sipPacket.getCallId();
+    transaction.initiator = InternPool::getInstance()->intern(
+            sipPacket.getFrom());
+    transaction.method = sipPacket.getCseqMethod();
+    if (!m_map.insert( { k, move(transaction) }).second) {
+        return false;
+    }
+    m_expiryDeque.push_back( { now, move(k) });
+
+    if (m_map.size() > m_sizeMax)
+        m_sizeMax = m_map.size();
+    return true;
+}
+
+bool OodTransactionMap::find(const SipPacket& sipPacket,
+        OodTransaction& transaction) const {
+    string k = key(sipPacket);
+
+    lock_guard lock(m_mutex);
+    auto iter = m_map.find(k);
+    if (iter == m_map.end())
+        return false;
+    transaction = iter->second;
+    return true;
+}
+
+size_t OodTransactionMap::erase(const SipPacket& sipPacket) {
+    string k = key(sipPacket);
+
+    // The key stays in m_expiryDeque until it expires.
+    lock_guard lock(m_mutex);
+    return m_map.erase(k);
+}
+
+void OodTransactionMap::handleTimeouts() {
+    auto now = steadyClock::now();
+
+    lock_guard lock(m_mutex);
+    expire(now);
+}
+
+size_t OodTransactionMap::size() const {
+    lock_guard lock(m_mutex);
+    return m_map.size();
+}
+
+size_t OodTransactionMap::sizeMax() const {
+    lock_guard lock(m_mutex);
+    return m_sizeMax;
+}
+
+void OodTransactionMap::expire(const steadyClock::time_point& now) {
+    auto maxAge = seconds(m_callxConfig->max_ood_transaction_age);
+
+    while (!m_expiryDeque.empty()
+            && now - m_expiryDeque.front().first > maxAge) {
+
+        // Erase the transaction if it is still the one we inserted at that
+        // time. It may have been answered and replaced in the meantime.
+        auto iter = m_map.find(m_expiryDeque.front().second);
+        if (iter != m_map.end()
+                && iter->second.creationTs == m_expiryDeque.front().first) {
+            L_t
+            << "Out-of-dialog transaction expired without final response. "
+            << "Call ID: "
+            << iter->second.callId;
+            m_map.erase(iter);
+        }
+        m_expiryDeque.pop_front();
+    }
+}
+
+} /* namespace callx */
@@ -0,0 +1,138 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * OodTransactionMap.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OODTRANSACTIONMAP_HPP_
+#define OODTRANSACTIONMAP_HPP_
+
+#include <deque>
+#include <unordered_map>
+#include "main/CallxSingleton.hpp"
+#include "main/CallxTypes.hpp"
+#include "main/callx.hpp"
+#include "sip/sip.hpp"
+
+namespace callx {
+
+class SipPacket;
+class CallxConfig;
+
+/**
+ * Compact record of an out-of-dialog transaction (OPTIONS, REGISTER).
+ */
+struct OodTransaction {
+    steadyClock::time_point creationTs;
+    std::string callId;
+    SipIdentity initiator;
+    requestMethodEnum method;
+};
+
+/**
+ * Table of pending out-of-dialog transactions. OPTIONS and REGISTER requests
+ * outside of a dialog are tracked here until the final response arrives, no
+ * Call object is created for them. Every entry lives max_ood_transaction_age
+ * seconds at most: the Watchdog expires them every TimeoutWheel tick, even if
+ * no further out-of-dialog request arrives. Entries are expired in insertion
+ * order, so an expiry run only visits the outdated entries.
+ */
+class OodTransactionMap:
+        public CallxSingleton<OodTransactionMap> {
+
+    friend class CallxSingleton<OodTransactionMap> ;
+
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~OodTransactionMap();
+
+    /**
+     * Inserts the transaction initiated by the SIP request. Outdated entries
+     * are expired before.
+     * @param sipPacket Parsed SIP request.
+     * @return False if the transaction is already known (retransmission).
+     */
+    bool insert(const SipPacket& sipPacket);
+
+    /**
+     * Searches the transaction matching the SIP response.
+     * @param sipPacket Parsed SIP response.
+     * @param transaction Copy of the transaction, if found.
+     * @return True if found.
+     */
+    bool find(const SipPacket& sipPacket, OodTransaction& transaction) const;
+
+    /**
+     * Deletes the transaction matching the SIP response.
+     * @param sipPacket Parsed SIP response.
+     * @return Number of deleted transactions.
+     */
+    size_t erase(const SipPacket& sipPacket);
+
+    /**
+     * Deletes all transactions older than max_ood_transaction_age. Called
+     * periodically by the Watchdog.
+     */
+    void handleTimeouts();
+
+    size_t size() const;
+    size_t sizeMax() const;
+
+private:
+
+    /**
+     * Hidden constructor
+     */
+    OodTransactionMap();
+
+    /**
+     * The key of a transaction is Call ID, Via branch and CSeq method.
+     */
+    static std::string key(const SipPacket& sipPacket);
+
+    /**
+     * Deletes all transactions older than max_ood_transaction_age.
+     */
+    void expire(const steadyClock::time_point& now);
+
+    typedef std::unordered_map<std::string, OodTransaction> OodTransactionMapType;
+
+    OodTransactionMapType m_map;
+
+    // keys in insertion order, used for the expiry
+    std::deque<std::pair<steadyClock::time_point, std::string>> m_expiryDeque;
+
+    mutable mutex m_mutex;
+    size_t m_sizeMax;
+    CallxConfig *m_callxConfig;
+};
+
+} /* namespace callx */
+
+#endif /* OODTRANSACTIONMAP_HPP_ */
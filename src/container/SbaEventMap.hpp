@@ -35,13 +35,16 @@
 #include "main/CallxSingleton.hpp"
 #include "main/CallxTypes.hpp"
 #include "sba/SbaEvent.hpp"
+#include "InternPool.hpp"
+#include "ListOptions.hpp"
+#include <vector>
 
 namespace callx {
 
 class SbaEvent;
 
 class SbaEventMap:
-        public ThreadFriendlyMap<std::string, std::shared_ptr<SbaEventDeque>>,
+        public ThreadFriendlyMap<InternId, std::shared_ptr<SbaEventDeque>>,
         public CallxSingleton<SbaEventMap> {
 
     friend class CallxSingleton<SbaEventMap> ;
@@ -56,118 +59,184 @@ public:
     }
 
     /**
-     *
-     * @return Iterator to the first element of the map.
+     * Adds an SBA event to the event list of the specific caller. It
+     * creates the map entry and the list, if not existent.
+     * @param caller Interned caller address.
+     * @param event
      */
-    std::map<std::string, std::shared_ptr<SbaEventDeque>>::iterator begin() {
-        return m_map.begin();
+    void pushEvent(InternId caller,
+            std::shared_ptr<SbaEvent> event) {
+        lock_guard lock(m_mutex);
+        auto iter = m_map.find(caller);
+        if (iter == m_map.end()) {
+            iter = m_map.insert(
+                    std::make_pair(caller, std::make_shared<SbaEventDeque>()))
+                    .first;
+            if (size() > m_sizeMax)
+                m_sizeMax++;
+        }
+
+        // A snapshot still reads the list, append to a copy of it.
+        if (!iter->second.unique())
+            iter->second = std::make_shared<SbaEventDeque>(*iter->second);
+        iter->second->push_back(std::move(event));
     }
 
+    typedef std::vector<std::pair<InternId,
+            std::shared_ptr<const SbaEventDeque>>> Snapshot;
+
     /**
-     *
-     * @return Iterator to the last element of the map.
+     * The event lists of all callers. Only the list pointers are copied
+     * under the lock; the lists are not modified afterwards, pushEvent()
+     * appends to a copy of a list still held by a snapshot.
+     * @return Caller and event list pairs, ordered by caller.
      */
-    std::map<std::string, std::shared_ptr<SbaEventDeque>>::iterator end() {
-        return m_map.end();
+    Snapshot snapshot() const {
+        Snapshot callers;
+        lock_guard lock(m_mutex);
+        callers.reserve(m_map.size());
+        for (auto iter = m_map.begin(); iter != m_map.end(); iter++) {
+            callers.push_back( { iter->first, iter->second });
+        }
+        return callers;
     }
 
     /**
-     *
+     * String representation of a page of events, grouped by caller. The
+     * lock is only held to take a snapshot of the event lists.
+     * @param options Filter (caller or Call-ID), offset and limit.
      * @return String representation (formated) of the map.
      */
-    std::string toString() const {
-        std::stringstream strstream;
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        // iterate over map, key is caller
-        for (auto callerIter = m_map.begin(); callerIter != m_map.end();
-                callerIter++) {
-            strstream << "\r\nCaller: " << callerIter->first << "\r\n";
-            auto callerQueue = callerIter->second;
-
-            // SBA events of the caller
-            for (auto eventIter = callerQueue->begin();
-                    eventIter != callerQueue->end(); eventIter++) {
-                std::shared_ptr<SbaEvent> event = (*eventIter);
-                time_t timestamp = systemClock::to_time_t(event->timestamp);
-                std::string tempTime(ctime(&timestamp));
-                strstream << "Event Type:\t"
-                          << sbaEventTypeEnumToString(event->eventType)
-                          << "\r\n"
-                          << "Call ID:\t"
-                          << event->callId
-                          << "\r\n"
-                          << "Timestamp:\t"
-                          << tempTime.substr(0, tempTime.size() - 1)
-                          << "\r\n"
-                          << "Initiator:\t"
-                          << event->transactionInitiator.address
-                          << "\r\n"
-                          << "Final rsponse:\t";
-                if (event->finalResponseCode != 0) {
-                    strstream << event->finalResponseCode
-                              << " "
-                              << event->finalResponseReason
-                              << "\r\n";
-                } else {
-                    strstream << "N/A" << "\r\n";
-                };
-
-                switch (event->eventType) {
-                case et_INVITE: {
-                    auto inviteEvent = std::static_pointer_cast<InviteEvent>(
-                            event);
-
-                    strstream << "flags [ack/reinvite/cancel]: "
-                              << inviteEvent->ackFlag
-                              << "/"
-                              << inviteEvent->reinviteFlag
-                              << "/"
-                              << inviteEvent->cancelFlag
-                              << "\r\n";
-                }
-                break;
-                case et_BYE: {
-                    auto byeEvent = std::static_pointer_cast<ByeEvent>(event);
-
-                    auto duration = boost::chrono::duration_cast<seconds>(
-                            byeEvent->callDuration);
-
-                    auto durationMinutes =
-                            boost::chrono::duration_cast<minutes>(
-                                    duration % 60);
-                    auto durationSeconds = duration - durationMinutes * 60;
-
-                    strstream << "Call duration:\t"
-                              << durationMinutes
-                              << " "
-                              << durationSeconds
-                              << "\r\n";
-                }
-                break;
-                case et_CANCEL: {
-                    auto optionsEvent = std::static_pointer_cast<OptionsEvent>(
-                            event);
+    std::string toString(const ListOptions& options) const {
+        InternPool *internPool = InternPool::getInstance();
+        std::vector<std::pair<InternId, std::shared_ptr<SbaEvent>>> page;
+        size_t total = 0;
+        {
+            Snapshot callers = snapshot();
 
-                    strstream << "";
-                }
-                break;
-                case et_OPTIONS: {
-                    auto optionsEvent = std::static_pointer_cast<OptionsEvent>(
-                            event);
+            // iterate over the callers
+            for (auto callerIter = callers.begin();
+                    callerIter != callers.end(); callerIter++) {
+                const SbaEventDeque& events = *callerIter->second;
 
-                    strstream << "Dialog established:\t"
-                              << (optionsEvent->dialogEstablished ? "yes" : "no");
+                // All events of a matching caller, copy the part on the
+                // page.
+                if (options.matches(internPool->lookup(callerIter->first))) {
+                    size_t first = 0;
+                    if (options.offset > total)
+                        first = options.offset - total;
+                    for (size_t i = first;
+                            i < events.size() && options.inPage(total + i);
+                            i++) {
+                        page.push_back( { callerIter->first, events[i] });
+                    }
+                    total += events.size();
+                    continue;
                 }
-                break;
-                default:
-                break;
+
+                // events with a matching Call-ID
+                for (auto eventIter = events.begin(); eventIter != events.end();
+                        eventIter++) {
+                    if (!options.matches((*eventIter)->callId))
+                        continue;
+                    if (options.inPage(total++))
+                        page.push_back( { callerIter->first, *eventIter });
                 }
-                strstream << "\r\n";
             }
         }
-        if (strstream.tellp() == 0) {
-            strstream << "\r\nSbaEventMap is empty.\r\n\r\n";
+
+        if (total == 0) {
+            return options.filter.empty() ?
+                    "\r\nSbaEventMap is empty.\r\n\r\n" :
+                    "\r\nNo matching event.\r\n\r\n";
+        }
+
+        std::stringstream strstream;
+        strstream << options.header("Events", total);
+        for (auto pageIter = page.begin(); pageIter != page.end(); pageIter++) {
+            if (pageIter == page.begin()
+                    || pageIter->first != (pageIter - 1)->first) {
+                strstream << "\r\nCaller: "
+                          << internPool->lookup(pageIter->first) << "\r\n";
+            }
+
+            const std::shared_ptr<SbaEvent>& event = pageIter->second;
+            time_t timestamp = systemClock::to_time_t(event->timestamp);
+            std::string tempTime(ctime(&timestamp));
+            strstream << "Event Type:\t"
+                      << sbaEventTypeEnumToString(event->eventType)
+                      << "\r\n"
+                      << "Call ID:\t"
+                      << event->callId
+                      << "\r\n"
+                      << "Timestamp:\t"
+                      << tempTime.substr(0, tempTime.size() - 1)
+                      << "\r\n"
+                      << "Initiator:\t"
+                      << internPool->lookup(
+                              event->transactionInitiator.address)
+                      << "\r\n"
+                      << "Final rsponse:\t";
+            if (event->finalResponseCode != 0) {
+                strstream << event->finalResponseCode
+                          << " "
+                          << event->finalResponseReason
+                          << "\r\n";
+            } else {
+                strstream << "N/A" << "\r\n";
+            };
+
+            switch (event->eventType) {
+            case et_INVITE: {
+                auto inviteEvent = std::static_pointer_cast<InviteEvent>(
+                        event);
+
+                strstream << "flags [ack/reinvite/cancel]: "
+                          << inviteEvent->ackFlag
+                          << "/"
+                          << inviteEvent->reinviteFlag
+                          << "/"
+                          << inviteEvent->cancelFlag
+                          << "\r\n";
+            }
+            break;
+            case et_BYE: {
+                auto byeEvent = std::static_pointer_cast<ByeEvent>(event);
+
+                auto duration = boost::chrono::duration_cast<seconds>(
+                        byeEvent->callDuration);
+
+                auto durationMinutes =
+                        boost::chrono::duration_cast<minutes>(
+                                duration % 60);
+                auto durationSeconds = duration - durationMinutes * 60;
+
+                strstream << "Call duration:\t"
+                          << durationMinutes
+                          << " "
+                          << durationSeconds
+                          << "\r\n";
+            }
+            break;
+            case et_CANCEL: {
+                auto optionsEvent = std::static_pointer_cast<OptionsEvent>(
+                        event);
+
+                strstream << "";
+            }
+            break;
+            case et_OPTIONS: {
+                auto optionsEvent = std::static_pointer_cast<OptionsEvent>(
+                        event);
+
+                strstream << "Dialog established:\t"
+                          << (optionsEvent->dialogEstablished ? "yes" : "no");
+            }
+            break;
+            default:
+            break;
+            }
+            strstream << "\r\n";
         }
         return strstream.str();
     }
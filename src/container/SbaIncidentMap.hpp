@@ -35,6 +35,11 @@
 #include "ThreadFriendlyMap.hpp"
 #include "main/CallxTypes.hpp"
 #include "sba/SbaIncident.hpp"
+#include "InternPool.hpp"
+#include "CallerIncidentSnapshot.hpp"
+#include "ListOptions.hpp"
+#include <memory>
+#include <atomic>
 
 namespace callx {
 
@@ -42,7 +47,7 @@ class SbaIncident;
 
 class SbaIncidentMap:
         public callx::CallxSingleton<SbaIncidentMap>,
-        public callx::ThreadFriendlyMap<std::string,
+        public callx::ThreadFriendlyMap<InternId,
                 std::shared_ptr<SbaIncidentSet>> {
 
     friend class CallxSingleton<SbaIncidentMap> ;
@@ -55,78 +60,173 @@ public:
     virtual ~SbaIncidentMap() {
         L_t
         << "D'tor";
+        delete m_snapshot.load();
     }
 
     /**
-     *
+     * Publishes a new snapshot of the callers with incidents, called by
+     * the SigBasedAna after each run. The replaced snapshot is deleted as
+     * soon as no probe can hold it any more: publishSnapshot() switches the
+     * reader epoch and waits until the probes of the previous epoch have
+     * finished. A stalled probe delays the SigBasedAna, never a probe.
+     */
+    void publishSnapshot() {
+        std::vector<InternId> callers;
+        {
+            lock_guard lock(m_mutex);
+            for (auto iter = m_map.begin(); iter != m_map.end(); iter++) {
+                if (!iter->second->empty())
+                    callers.push_back(iter->first);
+            }
+        }
+
+        lock_guard lock(m_publishMutex);
+        const CallerIncidentSnapshot *retired = m_snapshot.exchange(
+                new CallerIncidentSnapshot(callers));
+
+        // Probes entering from now on count in the other epoch and load
+        // the new snapshot.
+        unsigned epoch = m_epoch.load();
+        m_epoch.store(epoch + 1);
+        while (m_readers[epoch & 1].load() != 0) {
+            std::this_thread::yield();
+        }
+        delete retired;
+    }
+
+    /**
+     * Tests the latest snapshot, used on the INVITE path. It takes no lock:
+     * the probe only registers in the reader count of the current epoch,
+     * see publishSnapshot().
+     * @param caller Caller address, eg. sip:blah@blubb
+     * @return True, if the caller had an incident at the last SBA run.
+     */
+    bool callerHasIncident(boost::string_ref caller) const {
+        unsigned epoch;
+        for (;;) {
+            epoch = m_epoch.load();
+            m_readers[epoch & 1].fetch_add(1);
+
+            // retry, if a publication switched the epoch meanwhile
+            if (m_epoch.load() == epoch)
+                break;
+            m_readers[epoch & 1].fetch_sub(1);
+        }
+        const CallerIncidentSnapshot *snapshot = m_snapshot.load();
+        bool result = snapshot && snapshot->contains(caller);
+        m_readers[epoch & 1].fetch_sub(1);
+        return result;
+    }
+
+    /**
+     * Adds an incident to the incident set of the caller. It creates the
+     * map entry and the set, if not existent.
+     * @param caller Interned caller address.
+     * @param incident
+     */
+    void insertIncident(InternId caller,
+            std::shared_ptr<SbaIncident> incident) {
+        lock_guard lock(m_mutex);
+        auto iter = m_map.find(caller);
+        if (iter == m_map.end()) {
+            iter = m_map.insert(
+                    std::make_pair(caller, std::make_shared<SbaIncidentSet>()))
+                    .first;
+            if (size() > m_sizeMax)
+                m_sizeMax++;
+        }
+        iter->second->insert(std::move(incident));
+    }
+
+    /**
+     * String representation of a page of callers with their worst
+     * incident per type. The lock is only held to select these incidents.
+     * @param options Filter (caller), offset and limit.
      * @return String representation (formated) of the map.
      */
-    std::string toString() const {
-        std::stringstream strstream;
-        std::lock_guard<std::mutex> lock(m_mutex);
+    std::string toString(const ListOptions& options) const {
+        InternPool *internPool = InternPool::getInstance();
+
+        // Worst (evilest) incidents per caller.
+        typedef std::map<incidentTypeEnum, std::shared_ptr<SbaIncident>>
+                IncidentEvilMap;
+        std::vector<std::pair<InternId, IncidentEvilMap>> page;
+        size_t total = 0;
+        {
+            lock_guard lock(m_mutex);
+
+            // Iterate over caller in IncidentMap.
+            for (auto callerIter = m_map.begin(); callerIter != m_map.end();
+                    callerIter++) {
+                if (!options.matches(internPool->lookup(callerIter->first)))
+                    continue;
+                if (!options.inPage(total++))
+                    continue;
+
+                page.push_back( { callerIter->first, IncidentEvilMap() });
+                IncidentEvilMap& incidentEvilMap = page.back().second;
+                auto incidentSet = callerIter->second;
+
+                for (auto incidentIter = incidentSet->begin();
+                        incidentIter != incidentSet->end(); incidentIter++) {
+                    auto incident = *incidentIter;
+
+                    // Find current incident in incidentEvilMap.
+                    auto incidentMaxIter =
+                            incidentEvilMap.find(incident->getType());
+
+                    // Insert incident, if it is the first of this type in
+                    // the incidentEvilMap.
+                    if (incidentMaxIter == incidentEvilMap.end()) {
+
+                        // insert incident
+                        incidentEvilMap.insert( { incident->getType(), incident });
+                    } else {
+
+                        // There is an incident of the same type in the
+                        // incidentEvilMap. Check if the current incident
+                        // from the incidentSet should overwrite the one in
+                        // the incidentEvilMap. The decision is based on the
+                        // value and on the information if a smaller or a
+                        // bigger value is more 'evil'.
+                        if ((incident->getValue()
+                                > incidentMaxIter->second->getValue()
+                                && incident->getHigherValueIsEvil())
+                                || (incident->getValue()
+                                        < incidentMaxIter->second->getValue()
+                                        && !incident->getHigherValueIsEvil())) {
+                            incidentMaxIter->second = incident;
+                        }
+                    }
+                }
+            }
+        }
 
         // Return if there are no caller in the SbaIncidentMap.
-        if (m_map.empty()) {
-            strstream << "\r\nSbaIncidentMap is empty.\r\n\r\n";
-            return strstream.str();
+        if (total == 0) {
+            return options.filter.empty() ?
+                    "\r\nSbaIncidentMap is empty.\r\n\r\n" :
+                    "\r\nNo matching caller.\r\n\r\n";
         }
 
-        strstream << "\r\n"
+        std::stringstream strstream;
+        strstream << options.header("Callers", total)
+                  << "\r\n"
                   << "Worst incidents per caller:"
                   << "\r\n\r\n";
 
-        // Iterate over caller in IncidentMap.
-        for (auto callerIter = m_map.begin(); callerIter != m_map.end();
-                callerIter++) {
-            auto incidentSet = callerIter->second;
+        for (auto pageIter = page.begin(); pageIter != page.end(); pageIter++) {
             strstream << "-----------------------------------------------"
                       << "\r\n"
                       << "caller:\t"
-                      << callerIter->first
+                      << internPool->lookup(pageIter->first)
                       << "\r\n"
                       << "-----------------------------------------------"
                       << "\r\n\r\n";
 
-            // Temporary map of the worst (evilest) incidents.
-            std::map<incidentTypeEnum, std::shared_ptr<SbaIncident>> incidentEvilMap;
-
-            for (auto incidentIter = incidentSet->begin();
-                    incidentIter != incidentSet->end(); incidentIter++) {
-                auto incident = *incidentIter;
-
-                // Find current incident in incidentEvilMap.
-                auto incidentMaxIter =
-                        incidentEvilMap.find(incident->getType());
-
-                // Insert incident, if it is the first of this type in
-                // the incidentEvilMap.
-                if (incidentMaxIter == incidentEvilMap.end()) {
-
-                    // insert incident
-                    incidentEvilMap.insert( { incident->getType(), incident });
-                } else {
-
-                    // There is an incident of the same type in the incidentEvilMap.
-                    // Check if the current incident from the incidentSet should
-                    // overwrite the one in the incidentEvilMap. The decision is
-                    // based on the value and on the information if a smaller
-                    // or a bigger value is more 'evil'.
-                    if ((incident->getValue()
-                            > incidentMaxIter->second->getValue()
-                            && incident->getHigherValueIsEvil())
-                            || (incident->getValue()
-                                    < incidentMaxIter->second->getValue()
-                                    && !incident->getHigherValueIsEvil())) {
-
-                        incidentEvilMap.erase(incident->getType()); // not necessary...
-                        incidentEvilMap.insert( { incident->getType(), incident });
-                    }
-                }
-            }
-
             // Output of the evilest incidents.
-            for (auto incidentIter = incidentEvilMap.begin();
-                    incidentIter != incidentEvilMap.end(); incidentIter++) {
+            for (auto incidentIter = pageIter->second.begin();
+                    incidentIter != pageIter->second.end(); incidentIter++) {
                 auto incident = incidentIter->second;
                 time_t timestamp =
                         systemClock::to_time_t(incident->getTimestamp());
@@ -152,11 +252,28 @@ protected:
     /**
      * Hidden constructor
      */
-    SbaIncidentMap() {
+    SbaIncidentMap()
+            : m_snapshot(nullptr),
+              m_epoch(0) {
         L_t
         << "C'tor";
+        m_readers[0] = 0;
+        m_readers[1] = 0;
+        L_i
+        << "Caller incident snapshot probes lock-free: "
+        << (m_snapshot.is_lock_free() && m_readers[0].is_lock_free());
     }
 
+    // latest snapshot
+    std::atomic<const CallerIncidentSnapshot*> m_snapshot;
+
+    // reader epoch and the probes running per epoch parity
+    std::atomic<unsigned> m_epoch;
+    mutable std::atomic<size_t> m_readers[2];
+
+    // serializes the publications
+    mutex m_publishMutex;
+
 }
 ;
 
@@ -0,0 +1,208 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * ShardedHashMap.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SHARDEDHASHMAP_HPP_
+#define SHARDEDHASHMAP_HPP_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "main/CallxTypes.hpp"
+#include "main/callx.hpp"
+
+namespace callx {
+
+/**
+ * Hash of a string key. Stored keys and lookup keys (string_ref) hash to
+ * the same value, so a key hash can be computed once, e.g. while parsing,
+ * and be passed to the map.
+ */
+struct StringRefHash {
+    size_t operator()(boost::string_ref key) const {
+        return boost::hash_range(key.begin(), key.end());
+    }
+    size_t operator()(const std::string& key) const {
+        return operator()(boost::string_ref(key));
+    }
+};
+
+/**
+ * Hash map with string keys, split into a power-of-two number of shards.
+ * Every shard has its own mutex, so threads working on different keys
+ * rarely block each other. Lookups take a string_ref and optionally a
+ * precomputed hash (see StringRefHash).
+ */
+template<typename Type>
+class ShardedHashMap {
+public:
+
+    /**
+     * @param shards Number of shards, rounded up to a power of two.
+     */
+    ShardedHashMap(size_t shards)
+            : m_shards(powerOfTwo(shards)),
+              m_shardMask(m_shards.size() - 1),
+              m_size(0),
+              m_sizeMax(0) {
+    }
+
+    virtual ~ShardedHashMap() {
+    }
+
+    void insert(std::pair<const std::string&, Type>&& p) {
+        insert(StringRefHash()(p.first), p.first, std::move(p.second));
+    }
+
+    void insert(size_t hash, const std::string& key, Type value) {
+        Shard& shard = getShard(hash);
+        lock_guard lock(shard.shardMutex);
+        if (shard.map.insert(std::make_pair(key, std::move(value))).second) {
+            size_t size = ++m_size;
+            if (size > m_sizeMax) {
+                m_sizeMax = size;
+            }
+        }
+    }
+
+    bool find(boost::string_ref key, Type& t) {
+        return find(StringRefHash()(key), key, t);
+    }
+
+    bool find(size_t hash, boost::string_ref key, Type& t) {
+        Shard& shard = getShard(hash);
+        lock_guard lock(shard.shardMutex);
+        auto iter = shard.map.find(key, PrecomputedHash(hash), KeyEqual());
+        if (iter == shard.map.end()) {
+            return false;
+        }
+        t = iter->second;
+        return true;
+    }
+
+    size_t erase(boost::string_ref key) {
+        return erase(StringRefHash()(key), key);
+    }
+
+    size_t erase(size_t hash, boost::string_ref key) {
+        Shard& shard = getShard(hash);
+        lock_guard lock(shard.shardMutex);
+        auto iter = shard.map.find(key, PrecomputedHash(hash), KeyEqual());
+        if (iter == shard.map.end()) {
+            return 0;
+        }
+        shard.map.erase(iter);
+        m_size--;
+        return 1;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    size_t sizeMax() const {
+        return m_sizeMax;
+    }
+
+    size_t shardCount() const {
+        return m_shards.size();
+    }
+
+    /**
+     * Copies the values of one shard. Only this shard is locked while
+     * copying, the values can be processed without holding any lock.
+     * @param shard Shard index, less than shardCount()
+     * @param values The values are appended.
+     */
+    void copyShard(size_t shard, std::vector<Type>& values) const {
+        const Shard& s = m_shards[shard];
+        lock_guard lock(s.shardMutex);
+        for (auto iter = s.map.begin(); iter != s.map.end(); iter++) {
+            values.push_back(iter->second);
+        }
+    }
+
+    void eraseAll() {
+        for (size_t i = 0; i < m_shards.size(); i++) {
+            lock_guard lock(m_shards[i].shardMutex);
+            m_size -= m_shards[i].map.size();
+            m_shards[i].map.clear();
+        }
+    }
+
+protected:
+
+    // returns the precomputed hash for heterogeneous lookups
+    struct PrecomputedHash {
+        PrecomputedHash(size_t hash)
+                : hash(hash) {
+        }
+        size_t operator()(boost::string_ref) const {
+            return hash;
+        }
+        size_t hash;
+    };
+
+    struct KeyEqual {
+        bool operator()(boost::string_ref a, const std::string& b) const {
+            return a == boost::string_ref(b);
+        }
+        bool operator()(const std::string& a, boost::string_ref b) const {
+            return boost::string_ref(a) == b;
+        }
+    };
+
+    struct Shard {
+        boost::unordered_map<std::string, Type, StringRefHash> map;
+        mutable mutex shardMutex;
+    };
+
+    static size_t powerOfTwo(size_t n) {
+        size_t count = 1;
+        while (count < n) {
+            count <<= 1;
+        }
+        return count;
+    }
+
+    Shard& getShard(size_t hash) {
+        return m_shards[hash & m_shardMask];
+    }
+
+    std::vector<Shard> m_shards;
+    size_t m_shardMask;
+    std::atomic<size_t> m_size;
+    std::atomic<size_t> m_sizeMax;
+};
+
+} /* namespace callx */
+
+#endif /* SHARDEDHASHMAP_HPP_ */
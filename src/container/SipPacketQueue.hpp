@@ -32,6 +32,7 @@
 #define SIPPACKETQUEUE_HPP_
 
 #include "sip/SipPacket.hpp"
+#include "sip/SipPacketRecycler.hpp"
 #include "main/CallxSingleton.hpp"
 #include "ThreadFriendlyQueue.hpp"
 
@@ -39,7 +40,8 @@ namespace callx {
 
 class SipPacketQueue:
         public CallxSingleton<SipPacketQueue>,
-        public ThreadFriendlyQueue<std::unique_ptr<SipPacket> > {
+        public ThreadFriendlyQueue<
+                std::unique_ptr<SipPacket, SipPacketRecycler> > {
 
     friend class CallxSingleton<SipPacketQueue> ;
 
@@ -0,0 +1,76 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SipPacketRepository.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SIPPACKETREPOSITORY_HPP_
+#define SIPPACKETREPOSITORY_HPP_
+
+#include "ThreadFriendlyQueue.hpp"
+#include "main/CallxSingleton.hpp"
+#include <memory>
+
+namespace callx {
+
+class SipPacket;
+class SipPacketRecycler;
+
+/**
+ * Repository of unused SipPacket objects. A SipPacket keeps the buffers of
+ * its parse results when it is recycled, so a SipPacket taken from here
+ * usually parses without touching the heap.
+ */
+class SipPacketRepository:
+        public CallxSingleton<SipPacketRepository>,
+        public ThreadFriendlyQueue<
+                std::unique_ptr<SipPacket, SipPacketRecycler>> {
+public:
+
+    /**
+     * Destructor
+     */
+    virtual ~SipPacketRepository() {
+        L_t
+        << "D'tor";
+    }
+
+protected:
+
+    /**
+     * Hidden constructor
+     */
+    SipPacketRepository() {
+        L_t
+        << "C'tor";
+    }
+
+    friend class CallxSingleton<SipPacketRepository> ;
+
+};
+
+} /* namespace callx */
+#endif /* SIPPACKETREPOSITORY_HPP_ */
@@ -0,0 +1,88 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TimeoutWheel.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "TimeoutWheel.hpp"
+
+using namespace std;
+
+namespace callx {
+
+TimeoutWheel::TimeoutWheel()
+        : m_epoch(steadyClock::now()),
+          m_currentTick(0) {
+    L_t
+    << "C'tor";
+}
+
+TimeoutWheel::~TimeoutWheel() {
+    L_t
+    << "D'tor";
+}
+
+void TimeoutWheel::schedule(const steadyClock::time_point& deadline,
+        TimeoutEntry&& entry) {
+    lock_guard lock(m_mutex);
+    m_wheel.schedule(toTick(deadline), move(entry));
+}
+
+void TimeoutWheel::advance(const steadyClock::time_point& now,
+        vector<TimeoutEntry>& expired) {
+
+    // The current tick is the last one at or before now.
+    uint64_t tick = 0;
+    if (now > m_epoch) {
+        tick = boost::chrono::duration_cast<milliseconds>(now - m_epoch).count()
+                / Tick_Milliseconds;
+    }
+
+    lock_guard lock(m_mutex);
+    m_wheel.advance(tick, expired);
+    m_currentTick.store(m_wheel.currentTick(), memory_order_relaxed);
+}
+
+size_t TimeoutWheel::size() const {
+    lock_guard lock(m_mutex);
+    return m_wheel.size();
+}
+
+size_t TimeoutWheel::sizeMax() const {
+    lock_guard lock(m_mutex);
+    return m_wheel.sizeMax();
+}
+
+uint64_t TimeoutWheel::toTick(const steadyClock::time_point& tp) const {
+    if (tp <= m_epoch) {
+        return 0;
+    }
+    uint64_t ms = boost::chrono::duration_cast<milliseconds>(
+            tp - m_epoch + milliseconds(Tick_Milliseconds - 1)).count();
+    return ms / Tick_Milliseconds;
+}
+
+} /* namespace callx */
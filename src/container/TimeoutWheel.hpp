@@ -0,0 +1,123 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TimeoutWheel.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef TIMEOUTWHEEL_HPP_
+#define TIMEOUTWHEEL_HPP_
+
+#include <atomic>
+#include "TimerWheel.hpp"
+#include "main/CallxSingleton.hpp"
+#include "main/CallxTypes.hpp"
+#include "main/callx.hpp"
+
+namespace callx {
+
+class Call;
+class Transaction;
+
+// Timeout Type (to_)
+enum timeoutTypeEnum {
+    to_CALL = 0,
+    to_TRANSACTION
+};
+
+/**
+ * Scheduled check of a Call (max_call_age, max_call_rtp_inactivity,
+ * max_call_recording_time) or of a Transaction (max_transaction_inactivity).
+ */
+struct TimeoutEntry {
+    timeoutTypeEnum type;
+    std::weak_ptr<Call> call;
+    std::weak_ptr<Transaction> transaction;
+};
+
+/**
+ * Thread-safe timing wheel of all call and transaction timeouts. The
+ * Watchdog advances the wheel every tick, only the expiring entries are
+ * handled (see CallMap::handleCallTimeouts()).
+ */
+class TimeoutWheel:
+        public CallxSingleton<TimeoutWheel> {
+
+    friend class CallxSingleton<TimeoutWheel> ;
+
+public:
+
+    // length of one tick, the Watchdog period
+    static const int Tick_Milliseconds = 500;
+
+    /**
+     * Destructor
+     */
+    virtual ~TimeoutWheel();
+
+    /**
+     * Schedules a timeout. The entry expires with the first tick at or
+     * after the deadline.
+     */
+    void schedule(const steadyClock::time_point& deadline,
+            TimeoutEntry&& entry);
+
+    /**
+     * Advances the wheel to the current time.
+     * @param now
+     * @param expired All expired entries are appended.
+     */
+    void advance(const steadyClock::time_point& now,
+            std::vector<TimeoutEntry>& expired);
+
+    /**
+     * Current tick, a coarse clock readable without locking.
+     */
+    uint64_t currentTick() const {
+        return m_currentTick.load(std::memory_order_relaxed);
+    }
+
+    size_t size() const;
+    size_t sizeMax() const;
+
+private:
+
+    /**
+     * Hidden constructor
+     */
+    TimeoutWheel();
+
+    // first tick at or after tp
+    uint64_t toTick(const steadyClock::time_point& tp) const;
+
+    steadyClock::time_point m_epoch;
+    TimerWheel<TimeoutEntry> m_wheel;
+    std::atomic<uint64_t> m_currentTick;
+    mutable mutex m_mutex;
+};
+
+} /* namespace callx */
+
+#endif /* TIMEOUTWHEEL_HPP_ */
@@ -0,0 +1,186 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TimerWheel.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef TIMERWHEEL_HPP_
+#define TIMERWHEEL_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace callx {
+
+/**
+ * Hierarchical timing wheel. Time is counted in ticks. Level 0 has one slot
+ * per tick, every higher level has slots covering a whole lower level.
+ * Entries of a higher level slot are moved down (cascaded) when time
+ * reaches the slot, so advancing only visits expiring entries and the few
+ * entries being cascaded.
+ *
+ * Entries can not be cancelled. Owners of a rescheduled or obsolete
+ * timeout have to ignore the stale entry when it expires.
+ *
+ * The wheel is not thread-safe.
+ */
+template<typename Type>
+class TimerWheel {
+public:
+
+    static const int Slot_Bits = 6;
+    static const uint64_t Slots = 1 << Slot_Bits;
+    static const int Levels = 4;
+
+    // farthest possible expiry, later entries are clamped to it
+    static const uint64_t Max_Ticks = (uint64_t(1) << (Slot_Bits * Levels)) - 1;
+
+    TimerWheel()
+            : m_currentTick(0),
+              m_size(0),
+              m_sizeMax(0) {
+    }
+
+    virtual ~TimerWheel() {
+    }
+
+    /**
+     * Schedules an entry. Ticks not after the current tick expire with the
+     * next tick.
+     * @param expiryTick
+     * @param value
+     */
+    void schedule(uint64_t expiryTick, Type&& value) {
+        if (expiryTick <= m_currentTick) {
+            expiryTick = m_currentTick + 1;
+        } else if (expiryTick - m_currentTick > Max_Ticks) {
+            expiryTick = m_currentTick + Max_Ticks;
+        }
+        place(Entry(expiryTick, std::forward<Type>(value)));
+        if (++m_size > m_sizeMax) {
+            m_sizeMax = m_size;
+        }
+    }
+
+    /**
+     * Advances the wheel tick by tick up to toTick.
+     * @param toTick
+     * @param expired All expired entries are appended.
+     */
+    void advance(uint64_t toTick, std::vector<Type>& expired) {
+        while (m_currentTick < toTick) {
+            m_currentTick++;
+
+            // Cascade from the highest level whose slot index changes, so
+            // entries moved to a lower level can be cascaded further.
+            int level = 0;
+            while (level + 1 < Levels
+                    && (m_currentTick & levelMask(level + 1)) == 0) {
+                level++;
+            }
+            for (; level > 0; level--) {
+                cascade(level, expired);
+            }
+
+            std::vector<Entry>& slot = m_slots[0][m_currentTick & (Slots - 1)];
+            for (auto iter = slot.begin(); iter != slot.end(); iter++) {
+                expired.push_back(std::move(iter->value));
+            }
+            m_size -= slot.size();
+            slot.clear();
+        }
+    }
+
+    uint64_t currentTick() const {
+        return m_currentTick;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    size_t sizeMax() const {
+        return m_sizeMax;
+    }
+
+protected:
+
+    struct Entry {
+        Entry(uint64_t expiryTick, Type&& value)
+                : expiryTick(expiryTick),
+                  value(std::forward<Type>(value)) {
+        }
+        uint64_t expiryTick;
+        Type value;
+    };
+
+    // mask of the tick bits covered by the levels below level
+    static uint64_t levelMask(int level) {
+        return (uint64_t(1) << (Slot_Bits * level)) - 1;
+    }
+
+    // Puts an entry with expiryTick > m_currentTick into its slot.
+    void place(Entry&& entry) {
+        uint64_t delta = entry.expiryTick - m_currentTick;
+        int level = 0;
+        while (level + 1 < Levels && delta > levelMask(level + 1)) {
+            level++;
+        }
+        size_t index = (entry.expiryTick >> (Slot_Bits * level)) & (Slots - 1);
+        m_slots[level][index].push_back(std::move(entry));
+    }
+
+    // Moves the entries of the current slot of level to lower levels.
+    void cascade(int level, std::vector<Type>& expired) {
+        size_t index = (m_currentTick >> (Slot_Bits * level)) & (Slots - 1);
+        std::vector<Entry> entries;
+        entries.swap(m_slots[level][index]);
+        for (auto iter = entries.begin(); iter != entries.end(); iter++) {
+            if (iter->expiryTick <= m_currentTick) {
+                expired.push_back(std::move(iter->value));
+                m_size--;
+            } else {
+                place(std::move(*iter));
+            }
+        }
+
+        // keep the capacity of the slot
+        entries.clear();
+        if (m_slots[level][index].empty()) {
+            m_slots[level][index].swap(entries);
+        }
+    }
+
+    std::vector<Entry> m_slots[Levels][Slots];
+    uint64_t m_currentTick;
+    size_t m_size;
+    size_t m_sizeMax;
+};
+
+} /* namespace callx */
+
+#endif /* TIMERWHEEL_HPP_ */
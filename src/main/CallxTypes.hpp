@@ -37,8 +37,10 @@
 #include <queue>
 #include <list>
 #include <set>
+#include <utility>
 #include <thread>
 #include <map>
+#include <stdint.h>
 #include "boost/chrono.hpp"
 #include "boost/thread.hpp"
 
@@ -83,6 +85,69 @@ struct SipFromTo {
     std::string displayname;
 };
 
+/**
+ * ID of an interned string (see InternPool), 0 is the empty string. An
+ * InternId holds a reference on its string: the pool reuses the space of
+ * a string once no InternId refers to it any more.
+ */
+class InternId {
+public:
+    InternId()
+            : m_id(0) {
+    }
+
+    InternId(const InternId& other);
+    InternId& operator=(const InternId& other);
+    ~InternId();
+
+    InternId(InternId&& other)
+            : m_id(other.m_id) {
+        other.m_id = 0;
+    }
+
+    InternId& operator=(InternId&& other) {
+        std::swap(m_id, other.m_id);
+        return *this;
+    }
+
+    // position of the string in the pool
+    uint32_t value() const {
+        return m_id;
+    }
+
+    bool operator==(const InternId& other) const {
+        return m_id == other.m_id;
+    }
+
+    bool operator!=(const InternId& other) const {
+        return m_id != other.m_id;
+    }
+
+    bool operator<(const InternId& other) const {
+        return m_id < other.m_id;
+    }
+
+private:
+    friend class InternPool;
+
+    // takes over a reference counted by the InternPool
+    explicit InternId(uint32_t id)
+            : m_id(id) {
+    }
+
+    uint32_t m_id;
+};
+
+/**
+ * SipFromTo as it is kept beyond the SIP packet. Address and display name
+ * are interned, the tag is unique per dialog and stays a string.
+ */
+struct SipIdentity {
+    std::string tag;
+    InternId address;
+    InternId displayname;
+};
+
 
 
 } /* namespace callx */
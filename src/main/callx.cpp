@@ -25,6 +25,7 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <vector>
 #include <boost/date_time.hpp>
 #include "callx.hpp"
 #include "config/CallxConfig.hpp"
@@ -33,13 +34,20 @@
 #include "network/UdpHandler.hpp"
 #include "sip/SipProcessor.hpp"
 #include "audio/AudioHandler.hpp"
+#include "audio/AudioDecoderFactory.hpp"
+#include "audio/MemChunkPool.hpp"
 #include "console/Console.hpp"
 #include "container/CallMap.hpp"
+#include "container/OodTransactionMap.hpp"
 #include "container/CallDecodeQueue.hpp"
 #include "container/SbaEventMap.hpp"
 #include "container/PcmAudioQueue.hpp"
 #include "container/TlayerPacketQueue.hpp"
 #include "container/SipPacketQueue.hpp"
+#include "container/SipPacketRepository.hpp"
+#include "container/TimeoutWheel.hpp"
+#include "container/InternPool.hpp"
+#include "sip/SipPacketRecycler.hpp"
 #include "output/OutputHandler.hpp"
 #include "output/filesystem/WaveFileWriter.hpp"
 #include "sba/SigBasedAna.hpp"
@@ -214,8 +222,26 @@ void logConfig() {
 	<< callxConfig->min_sip_size;
 	L_i<< "tp_repository_size: "
 	<< callxConfig->tp_repository_size;
+	L_i<< "sp_repository_size: "
+	<< callxConfig->sp_repository_size;
 	L_i<< "mem_chunk_size: "
 	<< callxConfig->mem_chunk_size;
+	L_i<< "mem_chunk_pool_size: "
+	<< callxConfig->mem_chunk_pool_size;
+	L_i<< "rtp_streaming_decode: "
+	<< callxConfig->rtp_streaming_decode;
+	L_i<< "audio_handler_threads: "
+	<< callxConfig->audio_handler_threads;
+	L_i<< "resample_rate: "
+	<< callxConfig->resample_rate;
+	L_i<< "resample_filter_length: "
+	<< callxConfig->resample_filter_length;
+	L_i<< "use_vad: "
+	<< callxConfig->use_vad;
+	L_i<< "vad_threshold_db: "
+	<< callxConfig->vad_threshold_db;
+	L_i<< "vad_max_silence_ms: "
+	<< callxConfig->vad_max_silence_ms;
 	L_i<< "sba_pause: "
 	<< callxConfig->sba_pause;
 	L_i<< "record_if_incident_only: "
@@ -228,6 +254,10 @@ void logConfig() {
 	<< callxConfig->use_wavefile_output_interface;
 	L_i<< "wave_output_path: "
 	<< callxConfig->wave_output_path;
+	L_i<< "wave_output_stereo: "
+	<< callxConfig->wave_output_stereo;
+	L_i<< "wave_output_g711: "
+	<< callxConfig->wave_output_g711;
 	L_i<< "use_socket_output_interface: "
 	<< callxConfig->use_socket_output_interface;
 	L_i<< "socket_output_remote_ip: "
@@ -236,6 +266,8 @@ void logConfig() {
 	<< callxConfig->socket_output_remote_port;
 	L_i<< "socket_output_send_seconds: "
 	<< callxConfig->socket_output_send_seconds;
+	L_i<< "capture_budget_seconds: "
+	<< callxConfig->capture_budget_seconds;
 	L_i<< "use_viat_db: "
 	<< callxConfig->use_viat_db;
 	L_i<< "viat_db_connect_str: "
@@ -250,6 +282,14 @@ void logConfig() {
 	<< callxConfig->max_call_age;
 	L_i<< "max_call_age_if_error: "
 	<< callxConfig->max_call_age_if_error;
+	L_i<< "max_ood_transaction_age: "
+	<< callxConfig->max_ood_transaction_age;
+	L_i<< "sip_retransmission_window: "
+	<< callxConfig->sip_retransmission_window;
+	L_i<< "max_transaction_inactivity: "
+	<< callxConfig->max_transaction_inactivity;
+	L_i<< "call_map_shards: "
+	<< callxConfig->call_map_shards;
 
 	/* SBA config -> */
 	L_i<< "sba_call_attempts_period: "
@@ -298,13 +338,28 @@ void run(CallxConfig *callxConfig) {
 	<< tlayerPacketQueue->size()
 	<< " elements.";
 
+	/* Create SipPacket repository and objects. */
+	SipPacketRepository *sipPacketRepository =
+			SipPacketRepository::getInstance();
+	for (int i = 1; i <= callxConfig->sp_repository_size; i++) {
+
+		sipPacketRepository->push(
+				move(make_unique<SipPacket, SipPacketRecycler>()));
+	}
+	L_t<< "The SipPacket repository has got "
+	<< sipPacketRepository->size()
+	<< " elements.";
+
 	/* Create thread objects. */
 	unique_ptr<Console> console(new Console());
 	unique_ptr<PcapHandler> pcapHandler(new PcapHandler());
 	unique_ptr<TlayerDispatcher> tlayerDispatcher(new TlayerDispatcher());
 	unique_ptr<UdpHandler> udpHandler(new UdpHandler());
 	unique_ptr<SipProcessor> sipProcessor(new SipProcessor());
-	unique_ptr<AudioHandler> audioHandler(new AudioHandler());
+	vector<unique_ptr<AudioHandler> > audioHandlers;
+	for (int i = 0; i < callxConfig->audio_handler_threads; i++) {
+		audioHandlers.push_back(unique_ptr<AudioHandler>(new AudioHandler()));
+	}
 	unique_ptr<OutputHandler> outputHandler(new OutputHandler());
 	unique_ptr<SigBasedAna> sigBasedAna(new SigBasedAna());
 	unique_ptr<Watchdog> watchdog(new Watchdog());
@@ -318,7 +373,9 @@ void run(CallxConfig *callxConfig) {
 	tlayerDispatcher->start();
 	udpHandler->start();
 	sipProcessor->start();
-	audioHandler->start();
+	for (auto& audioHandler : audioHandlers) {
+		audioHandler->start();
+	}
 	outputHandler->start();
 	sigBasedAna->start();
 	watchdog->start();
@@ -345,7 +402,10 @@ void run(CallxConfig *callxConfig) {
 	bool tlayerDispatcher_stopped = tlayerDispatcher->stop();
 	bool udphandler_stopped = udpHandler->stop();
 	bool sipProcessor_stopped = sipProcessor->stop();
-	bool audioHandler_stopped = audioHandler->stop();
+	bool audioHandler_stopped = true;
+	for (auto& audioHandler : audioHandlers) {
+		audioHandler_stopped = audioHandler->stop() && audioHandler_stopped;
+	}
 	bool outputHandler_stopped = outputHandler->stop();
 	bool sigBasedAna_stopped = sigBasedAna->stop();
 	bool watchdog_stopped = watchdog->stop();
@@ -362,7 +422,9 @@ void run(CallxConfig *callxConfig) {
 		tlayerDispatcher->join();
 		udpHandler->join();
 		sipProcessor->join();
-		audioHandler->join();
+		for (auto& audioHandler : audioHandlers) {
+			audioHandler->join();
+		}
 		outputHandler->join();
 		sigBasedAna->join();
 		watchdog->join();
@@ -377,7 +439,7 @@ void run(CallxConfig *callxConfig) {
 	tlayerDispatcher.reset();
 	udpHandler.reset();
 	sipProcessor.reset();
-	audioHandler.reset();
+	audioHandlers.clear();
 	outputHandler.reset();
 	sigBasedAna.reset();
 	watchdog.reset();
@@ -388,11 +450,27 @@ void run(CallxConfig *callxConfig) {
 	delete (UdpPacketQueue::getInstance());
 	delete (SipPacketQueue::getInstance());
 	delete (CallMap::getInstance());
+	delete (OodTransactionMap::getInstance());
 	delete (SbaEventMap::getInstance());
 	delete (CallDecodeQueue::getInstance());
 	delete (PcmAudioQueue::getInstance());
+	delete (AudioDecoderFactory::getInstance());
+	delete (MemChunkPool::getInstance());
+	delete (TimeoutWheel::getInstance());
+	delete (InternPool::getInstance());
 	delete (CallxConfig::getInstance());
 
+	L_i<< "Deleting "
+	<< sipPacketRepository->size()
+	<< " SipPacket objects and SipPacketRepository.";
+	unique_ptr<SipPacket, SipPacketRecycler> sipPacket;
+	while (!sipPacketRepository->empty()) {
+		if (sipPacketRepository->waitAndPop(sipPacket)) {
+			delete sipPacket.release();
+		}
+	}
+	delete (SipPacketRepository::getInstance());
+
 	L_i<< "Deleting "
 	<< tlayerPacketQueue->size()
 	<< " TlayerPacket objects and TlayerPacketQueue.";
@@ -33,6 +33,8 @@
 #include "TlayerPacket.hpp"
 #include "container/UdpPacketQueue.hpp"
 #include "container/SipPacketQueue.hpp"
+#include "container/SipPacketRepository.hpp"
+#include "sip/SipPacketRecycler.hpp"
 #include "container/RtpSinkMap.hpp"
 
 using namespace std;
@@ -45,6 +47,7 @@ UdpHandler::UdpHandler() {
     classname = "UdpHandler";
     m_udpPacketQueue = UdpPacketQueue::getInstance();
     m_sipPacketQueue = SipPacketQueue::getInstance();
+    m_sipPacketRepository = SipPacketRepository::getInstance();
     m_rtpSinkMap = RtpSinkMap::getInstance();
 }
 
@@ -64,7 +67,7 @@ void UdpHandler::worker() {
 
     unique_ptr<TlayerPacket, TlayerPacketRecycler> tlayerPacket;
     shared_ptr<RtpSink> rtpSink;
-    unique_ptr<SipPacket> sipPacket;
+    unique_ptr<SipPacket, SipPacketRecycler> sipPacket;
 
     size_t minSipSize = m_callxConfig->min_sip_size;
     const char sipIdentStr[] = "SIP/2.0";
@@ -145,8 +148,12 @@ void UdpHandler::worker() {
                 }
             }
             if (isSip) {
-                // create new SipPacket object
-                sipPacket.reset(new SipPacket(move(tlayerPacket)));
+                // Get SipPacket object from SipPacketRepository, create a
+                // new one only if the repository is empty.
+                if (!m_sipPacketRepository->tryPop(sipPacket)) {
+                    sipPacket.reset(new SipPacket());
+                }
+                sipPacket->fill(move(tlayerPacket));
 
                 // Push SipPacket into SipPacketQueue
                 m_sipPacketQueue->push(move(sipPacket));
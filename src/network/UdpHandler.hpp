@@ -37,6 +37,7 @@ namespace callx {
 
 class UdpPacketQueue;
 class SipPacketQueue;
+class SipPacketRepository;
 class RtpSinkMap;
 
 class UdpHandler: public CallxThread {
@@ -66,6 +67,7 @@ public:
 protected:
     UdpPacketQueue *m_udpPacketQueue;
     SipPacketQueue *m_sipPacketQueue;
+    SipPacketRepository *m_sipPacketRepository;
     RtpSinkMap *m_rtpSinkMap;
 };
 
@@ -33,6 +33,8 @@
 #include "output/filesystem/WaveFileWriter.hpp"
 #include "audio/PcmAudio.hpp"
 #include "audio/MemChunk.hpp"
+#include "audio/G711Decoder.hpp"
+#include "container/InternPool.hpp"
 #include "boost/thread.hpp"
 
 using namespace std;
@@ -105,9 +107,12 @@ void OutputHandler::worker() {
 
         // If use_viat_db is true, create caller and call entries in the DB.
         if (m_callxConfig->use_viat_db) {
-            m_dbCallId = m_viatDb->insertCall(m_currPcmAudio->getCaller()
-                    .displayname,
-                    m_currPcmAudio->getCaller().address);
+            InternPool *internPool = InternPool::getInstance();
+            m_dbCallId = m_viatDb->insertCall(
+                    internPool->lookup(m_currPcmAudio->getCaller().displayname)
+                            .to_string(),
+                    internPool->lookup(m_currPcmAudio->getCaller().address)
+                            .to_string());
 
             // Skip in case of database error.
             if (m_dbCallId == -1) {
@@ -150,13 +155,23 @@ void OutputHandler::pushToFile() {
     } else {
         fileName += m_currPcmAudio->getCallId();
     }
-    if (m_currPcmAudio->isCallerAudio()) {
-        fileName += "_caller";
-    } else {
-        fileName += "_callee";
+    // stereo files hold both directions of the call
+    if (m_currPcmAudio->getChannels() == 1) {
+        if (m_currPcmAudio->isCallerAudio()) {
+            fileName += "_caller";
+        } else {
+            fileName += "_callee";
+        }
     }
     fileName += ".wav";
-    WaveFileWriter waveFileWriter(fileName);
+    u_int16_t format = WaveFileWriter::Format_Pcm;
+    if (m_currPcmAudio->getEncoding() == ac_PCMA) {
+        format = WaveFileWriter::Format_Alaw;
+    } else if (m_currPcmAudio->getEncoding() == ac_PCMU) {
+        format = WaveFileWriter::Format_Mulaw;
+    }
+    WaveFileWriter waveFileWriter(fileName, m_currPcmAudio->getSampleRate(),
+            m_currPcmAudio->getChannels(), format);
 
     // get the chunk queue that contains PCM data
     auto currMemChunkDeque = m_currPcmAudio->getChunkDeque();
@@ -170,10 +185,69 @@ void OutputHandler::pushToFile() {
 
 void OutputHandler::pushToSocket() {
 
+    // G.711 stored without decoding, only the part sent is decoded
+    if (m_currPcmAudio->getEncoding() != ac_UNDEFINED) {
+        PcmAudio pcmAudio(m_currPcmAudio->getCallId(),
+                m_currPcmAudio->getCaller(), m_currPcmAudio->getCallee(),
+                m_currPcmAudio->getStartTs(),
+                m_currPcmAudio->isCallerAudio());
+        pcmAudio.setSampleRate(m_currPcmAudio->getSampleRate());
+
+        G711Decoder g711Decoder(m_currPcmAudio->getEncoding() == ac_PCMA);
+        size_t maxSamples = m_callxConfig->socket_output_send_seconds
+                * m_currPcmAudio->getSampleRate();
+        vector<short> samples;
+        auto currMemChunkDeque = m_currPcmAudio->getChunkDeque();
+        for (auto iter = currMemChunkDeque->begin();
+                iter != currMemChunkDeque->end()
+                        && samples.size() < maxSamples; iter++) {
+            size_t n = min((*iter)->fillingLevel(),
+                    maxSamples - samples.size());
+            samples.resize(samples.size() + n);
+            g711Decoder.decode(reinterpret_cast<u_char*>((*iter)->data()), n,
+                    samples.data() + samples.size() - n);
+        }
+        pcmAudio.append(samples.data(), samples.size());
+        sendToSocket(pcmAudio);
+        return;
+    }
+
+    if (m_currPcmAudio->getChannels() == 1) {
+        sendToSocket(*m_currPcmAudio);
+        return;
+    }
+
+    // The feature extractor gets the recorded directions of a stereo call
+    // one after the other, as in mono mode.
+    size_t maxSamples = m_currPcmAudio->voicedEnd(
+            m_callxConfig->socket_output_send_seconds
+                    * m_currPcmAudio->getSampleRate());
+    for (u_short channel = 0; channel < 2; channel++) {
+        if (!(channel == 0 ?
+                m_callxConfig->record_caller : m_callxConfig->record_callee))
+            continue;
+
+        PcmAudio pcmAudio(m_currPcmAudio->getCallId(),
+                m_currPcmAudio->getCaller(), m_currPcmAudio->getCallee(),
+                m_currPcmAudio->getStartTs(), channel == 0);
+        pcmAudio.setSampleRate(m_currPcmAudio->getSampleRate());
+
+        // The channel keeps the silence spans, so sendToSocket() does not
+        // count the kept silence either.
+        m_currPcmAudio->copyChannel(channel, maxSamples, pcmAudio);
+        sendToSocket(pcmAudio);
+    }
+}
+
+void OutputHandler::sendToSocket(PcmAudio& pcmAudio) {
+
     boost::system::error_code ec;
 
-    // max bytes = seconds * sample rate * 2 bytes
-    u_int maxBytes = m_callxConfig->socket_output_send_seconds * 8000 * 2;
+    // max bytes = seconds * sample rate * 2 bytes, silence kept by the VAD
+    // is not counted
+    u_int maxBytes = pcmAudio.voicedEnd(
+            m_callxConfig->socket_output_send_seconds
+                    * pcmAudio.getSampleRate()) * 2;
     u_int sentBytes = 0;
     u_int bytesToSend = 0;
 
@@ -182,7 +256,7 @@ void OutputHandler::pushToSocket() {
             << maxBytes;
 
     // get the chunk queue that contains PCM data
-    auto currMemChunkDeque = m_currPcmAudio->getChunkDeque();
+    auto currMemChunkDeque = pcmAudio.getChunkDeque();
 
     // send data (Call ID)
     sentBytes = 0;
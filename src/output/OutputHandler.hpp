@@ -62,6 +62,9 @@ private:
     void pushToFile();
     void pushToSocket();
 
+    // sends the mono audio to the feature extractor
+    void sendToSocket(PcmAudio& pcmAudio);
+
     PcmAudioQueue *m_pcmAudioQueue;
     std::unique_ptr<PcmAudio> m_currPcmAudio;
     long m_dbCallId;
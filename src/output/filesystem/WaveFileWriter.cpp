@@ -36,28 +36,63 @@ using namespace std;
 
 namespace callx {
 
-WaveFileWriter::WaveFileWriter(const std::string& filename) {
-    fwrite(&waveHeader, sizeof(WaveHeader), 1, outFile);
+WaveFileWriter::WaveFileWriter(const std::string& filename,
+        u_int32_t sampleRate, u_int16_t channels, u_int16_t format)
+        : m_sampleRate(sampleRate),
+          m_channels(channels),
+          m_format(format) {
+
+    // placeholder, the sizes are known in the destructor
+    writeHeader();
     setFilename(filename);
 }
 
 WaveFileWriter::~WaveFileWriter() {
     L_t << "WaveFileWriter destructor, writing WAVE header.";
+
+    // RIFF chunks have an even size, G.711 data may need a pad byte
+    if (totalSize % 2) {
+        u_char pad = 0;
+        fwrite(&pad, sizeof(pad), 1, outFile);
+    }
+    rewind(outFile);
+    writeHeader();
+}
+
+void WaveFileWriter::writeHeader() {
+    // G.711 has one byte per sample
+    u_int16_t sampleSize = m_format == Format_Pcm ? 2 : 1;
+    bool pcm = m_format == Format_Pcm;
+
     waveHeader.rwChunkID = whdr_RIFF;
-    waveHeader.rwChunkSize = 36 + totalSize;
     waveHeader.rwRiffType = whdr_WAVE;
     waveHeader.fChunkId = whdr_fmt;
-    waveHeader.fChunkSize = 16;
-    waveHeader.fFormat = 1;
-    waveHeader.fNumChannels = 1;
-    waveHeader.fSampleRate = 8000;
-    waveHeader.fByteRate = 16000;
-    waveHeader.fBlockAlign = 2;
-    waveHeader.fBitsPerSample = 16;
-    waveHeader.dChunkId = whdr_data;
-    waveHeader.dChunkSize = totalSize;
-    rewind(outFile);
+
+    // Non-PCM formats have the cbSize field and a fact chunk (sample count).
+    waveHeader.fChunkSize = pcm ? 16 : 18;
+    waveHeader.fFormat = m_format;
+    waveHeader.fNumChannels = m_channels;
+    waveHeader.fSampleRate = m_sampleRate;
+    waveHeader.fByteRate = m_sampleRate * sampleSize * m_channels;
+    waveHeader.fBlockAlign = sampleSize * m_channels;
+    waveHeader.fBitsPerSample = 8 * sampleSize;
+    factChunk.factChunkId = whdr_fact;
+    factChunk.factChunkSize = 4;
+    factChunk.factSampleLength = totalSize / (sampleSize * m_channels);
+    dataChunk.dChunkId = whdr_data;
+    dataChunk.dChunkSize = totalSize;
+
+    waveHeader.rwChunkSize = 4 + 8 + waveHeader.fChunkSize
+            + (pcm ? 0 : sizeof(FactChunk)) + sizeof(DataChunk)
+            + totalSize + totalSize % 2;
+
     fwrite(&waveHeader, sizeof(WaveHeader), 1, outFile);
+    if (!pcm) {
+        u_int16_t cbSize = 0;
+        fwrite(&cbSize, sizeof(cbSize), 1, outFile);
+        fwrite(&factChunk, sizeof(FactChunk), 1, outFile);
+    }
+    fwrite(&dataChunk, sizeof(DataChunk), 1, outFile);
 }
 
 } /* namespace callx */
@@ -37,39 +37,67 @@ namespace callx {
 
 class WaveFileWriter: public RawFileWriter {
 public:
-  WaveFileWriter(const std::string& filename);
+
+  // WAVE format tags: 16 bit PCM, 8 bit G.711 A-law and u-law
+  static const u_int16_t Format_Pcm = 1;
+  static const u_int16_t Format_Alaw = 6;
+  static const u_int16_t Format_Mulaw = 7;
+
+  WaveFileWriter(const std::string& filename, u_int32_t sampleRate = 8000,
+          u_int16_t channels = 1, u_int16_t format = Format_Pcm);
   ~WaveFileWriter();
 
 private:
 
+  // samples per second, interleaved channels and format tag of the data
+  u_int32_t m_sampleRate;
+  u_int16_t m_channels;
+  u_int16_t m_format;
+
+  // writes the header at the current file position, with the sizes of
+  // the data written so far
+  void writeHeader();
+
   struct WaveHeader {
     // RIFF-WAVE (rw) Chunk
     u_int32_t rwChunkID; // "RIFF"
-    u_int32_t rwChunkSize; // this chunk size - 8 [rest of this chunk] + fChunkSize + 8 + dChunkSize + 8
+    u_int32_t rwChunkSize; // size of the rest of the file: 4 + all chunks with their headers
     u_int32_t rwRiffType; // "WAVE"
 
-    // Format (f) Chunk
+    // Format (f) Chunk, followed by cbSize = 0 (2 bytes) if not PCM
     u_int32_t fChunkId; // "fmt"
-    u_int32_t fChunkSize; // this chunk size - 8 [rest of this chunk]
-    u_int16_t fFormat; // PCM = 1
+    u_int32_t fChunkSize; // this chunk size - 8 [rest of this chunk]: 16 PCM, 18 else
+    u_int16_t fFormat; // PCM = 1, A-law = 6, u-law = 7
     u_int16_t fNumChannels; // 1 mono, 2 stereo
     u_int32_t fSampleRate; // samples per second
     u_int32_t fByteRate; // bytes per second
     u_int16_t fBlockAlign; // size per sample: 1 or 2 bytes
     u_int16_t fBitsPerSample; // 8, 16, ...
+  };
+
+  // Fact (fact) Chunk, required if not PCM
+  struct FactChunk {
+    u_int32_t factChunkId; // "fact"
+    u_int32_t factChunkSize; // 4
+    u_int32_t factSampleLength; // samples per channel
+  };
 
-    // Data (d) Chunk
+  // Data (d) Chunk header
+  struct DataChunk {
     u_int32_t dChunkId; // "data"
     u_int32_t dChunkSize; // NumSamples * NumChannels * BitsPerSample/8
   };
 
   WaveHeader waveHeader;
+  FactChunk factChunk;
+  DataChunk dataChunk;
 
-  // defines the strings "RIFF", "WAVE", "fmt" and "data" as 4 byte values
-  // used in Wave Header
+  // defines the strings "RIFF", "WAVE", "fmt", "fact" and "data" as 4 byte
+  // values used in Wave Header
   static const u_int32_t whdr_RIFF = 0x46464952;  // RIFF
   static const u_int32_t whdr_WAVE = 0x45564157;  // WAVE
   static const u_int32_t whdr_fmt  = 0x20746D66;  // fmt
+  static const u_int32_t whdr_fact = 0x74636166;  // fact
   static const u_int32_t whdr_data = 0x61746164;  // data
 };
 
@@ -59,8 +59,8 @@ inline static std::string sbaEventTypeEnumToString(SbaEventTypeEnum e) {
  */
 struct SbaEvent {
     SbaEvent(const std::string &callId,
-            const SipFromTo &caller,
-            const SipFromTo &transactionInitiator)
+            const SipIdentity &caller,
+            const SipIdentity &transactionInitiator)
             : timestamp(systemClock::now()),
               callId(callId),
               caller(caller),
@@ -70,8 +70,8 @@ struct SbaEvent {
     }
     systemClock::time_point timestamp;
     std::string callId;
-    SipFromTo caller;
-    SipFromTo transactionInitiator;
+    SipIdentity caller;
+    SipIdentity transactionInitiator;
     u_int finalResponseCode;
     std::string finalResponseReason;
     SbaEventTypeEnum eventType;
@@ -86,8 +86,8 @@ struct SbaEvent {
 struct InviteEvent:
         public SbaEvent {
     InviteEvent(const std::string &callId,
-            const SipFromTo &caller,
-            const SipFromTo &transactionInitiator)
+            const SipIdentity &caller,
+            const SipIdentity &transactionInitiator)
             : SbaEvent(callId, caller, transactionInitiator),
               reinviteFlag(false),
               cancelFlag(false),
@@ -112,8 +112,8 @@ struct InviteEvent:
 struct ByeEvent:
         public SbaEvent {
     ByeEvent(const std::string &callId,
-            const SipFromTo &caller,
-            const SipFromTo &transactionInitiator)
+            const SipIdentity &caller,
+            const SipIdentity &transactionInitiator)
             : SbaEvent(callId, caller, transactionInitiator) {
         L_t
         << "C'tor ByeEvent";
@@ -134,8 +134,8 @@ struct ByeEvent:
 struct CancelEvent:
         public SbaEvent {
     CancelEvent(const std::string &callId,
-            const SipFromTo &caller,
-            const SipFromTo &transactionInitiator)
+            const SipIdentity &caller,
+            const SipIdentity &transactionInitiator)
             : SbaEvent(callId, caller, transactionInitiator) {
         L_t
         << "C'tor CancelEvent";
@@ -154,8 +154,8 @@ struct CancelEvent:
 struct OptionsEvent:
         public SbaEvent {
     OptionsEvent(const std::string &callId,
-            const SipFromTo &caller,
-            const SipFromTo &transactionInitiator)
+            const SipIdentity &caller,
+            const SipIdentity &transactionInitiator)
             : SbaEvent(callId, caller, transactionInitiator),
               dialogEstablished(false) {
         L_t
@@ -54,7 +54,7 @@ inline std::string incidentTypeToString(incidentTypeEnum type) {
 class SbaIncident {
 public:
     SbaIncident(incidentTypeEnum type,
-            std::string user,
+            InternId user,
             int period,
             float value,
             bool higherValueIsEvil,
@@ -77,7 +77,7 @@ public:
         return m_timestamp;
     }
 
-    const std::string& getUser() const {
+    InternId getUser() const {
         return m_user;
     }
 
@@ -104,7 +104,7 @@ public:
 protected:
     systemClock::time_point m_timestamp;
     incidentTypeEnum m_type;
-    std::string m_user;
+    InternId m_user;
     int m_period;
     float m_value;
     bool m_higherValueIsEvil;
@@ -93,12 +93,14 @@ void SigBasedAna::analyze() {
 
 	m_analyzeTs = systemClock::now();
 
-	// for every caller in SbaEventMap...
-	for (auto callerIter = m_sbaEventMap->begin();
-			callerIter != m_sbaEventMap->end(); callerIter++) {
+	// for every caller in SbaEventMap, the SipProcessor keeps on pushing
+	// events to copies of the lists
+	SbaEventMap::Snapshot callers = m_sbaEventMap->snapshot();
+	for (auto callerIter = callers.begin(); callerIter != callers.end();
+			callerIter++) {
 
 		m_currCaller = callerIter->first;
-		m_currSbaEventDeque = callerIter->second;
+		m_currSbaEventDeque = move(callerIter->second);
 
 		analyzeCallAttempts();
 		analyzeCallsConcurrent();
@@ -107,6 +109,10 @@ void SigBasedAna::analyze() {
 		analyzeCallDurationCumulative();
 		analyzeCallsClosedByCallee();
 	}
+	m_currSbaEventDeque.reset();
+
+	// INVITE processing reads the flagged callers from this snapshot.
+	m_sbaIncidentMap->publishSnapshot();
 }
 
 void SigBasedAna::analyzeCallAttempts() {
@@ -432,14 +438,9 @@ bool SigBasedAna::isInPeriod(systemClock::time_point eventTs, int period) {
 					> 0);
 }
 
-void SigBasedAna::insertIncident(const std::string& caller,
+void SigBasedAna::insertIncident(InternId caller,
 		std::shared_ptr<SbaIncident> incident) {
-	shared_ptr<SbaIncidentSet> incidentSet;
-	if (!m_sbaIncidentMap->find(caller, incidentSet)) {
-		incidentSet = make_shared<SbaIncidentSet>();
-		m_sbaIncidentMap->insert(make_pair(caller, incidentSet));
-	}
-	incidentSet->insert(incident);
+	m_sbaIncidentMap->insertIncident(caller, move(incident));
 }
 
 } /* namespace callx */
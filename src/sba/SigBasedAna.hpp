@@ -60,8 +60,8 @@ protected:
 
     systemClock::time_point m_analyzeTs;
 
-    std::string m_currCaller;
-    std::shared_ptr<SbaEventDeque> m_currSbaEventDeque;
+    InternId m_currCaller;
+    std::shared_ptr<const SbaEventDeque> m_currSbaEventDeque;
 
     void analyze();
     void analyzeCallAttempts();
@@ -85,10 +85,10 @@ private:
 
     /**
      * Pushed Incident into Callers incident set.
-     * @param caller Caller address
+     * @param caller Interned caller address
      * @param incident Shared pointer to SbaIncident object.
      */
-    void insertIncident(const std::string& caller,
+    void insertIncident(InternId caller,
             std::shared_ptr<SbaIncident> incident);
 };
 
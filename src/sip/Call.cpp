@@ -77,21 +77,25 @@ shared_ptr<Dialog> Call::getDialog() {
 	return m_dialog;
 }
 
-bool Call::findTransaction(const TransactionId& transactionId,
-		std::shared_ptr<Transaction>& transaction) {
-
-	auto iter = m_transactionMap.find(transactionId);
-	if (iter == m_transactionMap.end())
-		return false;
-	transaction = iter->second;
-	return true;
+bool Call::findTransaction(size_t branchHash, const string& branch,
+		requestMethodEnum method, shared_ptr<Transaction>& transaction) const {
+
+	for (auto iter = m_transactionTable.begin();
+			iter != m_transactionTable.end(); iter++) {
+		if (iter->branchHash == branchHash && iter->method == method
+				&& iter->transaction->getId().first == branch) {
+			transaction = iter->transaction;
+			return true;
+		}
+	}
+	return false;
 }
 
-bool Call::findInviteTransaction(std::shared_ptr<Transaction>& transaction) {
-	for (auto iter = m_transactionMap.begin(); iter != m_transactionMap.end();
-			iter++) {
-		if (iter->first.second == rm_INVITE) {
-			transaction = iter->second;
+bool Call::findInviteTransaction(shared_ptr<Transaction>& transaction) const {
+	for (auto iter = m_transactionTable.begin();
+			iter != m_transactionTable.end(); iter++) {
+		if (iter->method == rm_INVITE) {
+			transaction = iter->transaction;
 			return true;
 		}
 	}
@@ -99,11 +103,26 @@ bool Call::findInviteTransaction(std::shared_ptr<Transaction>& transaction) {
 }
 
 void Call::insertTransaction(shared_ptr<Transaction> transaction) {
-	m_transactionMap.insert( { transaction->getId(), transaction });
-}
-
-size_t Call::delTransaction(const TransactionId& transactionId) {
-	return m_transactionMap.erase(transactionId);
+	shared_ptr<Transaction> existing;
+	if (findTransaction(transaction->getBranchHash(),
+			transaction->getId().first, transaction->getCseqMethod(),
+			existing))
+		return;
+
+	size_t branchHash = transaction->getBranchHash();
+	requestMethodEnum method = transaction->getCseqMethod();
+	m_transactionTable.push_back( { branchHash, method, move(transaction) });
+}
+
+size_t Call::delTransaction(const shared_ptr<Transaction>& transaction) {
+	for (auto iter = m_transactionTable.begin();
+			iter != m_transactionTable.end(); iter++) {
+		if (iter->transaction == transaction) {
+			m_transactionTable.erase(iter);
+			return 1;
+		}
+	}
+	return 0;
 }
 
 void Call::checkRecordingTime(int maxSeconds) {
@@ -137,6 +156,32 @@ int Call::getRtpInactivityTime() {
 	return inactiveSeconds;
 }
 
+int Call::getCapturedSeconds() {
+	if (m_localRtpSinkMap->empty())
+		return 0;
+
+	size_t capturedSeconds = m_localRtpSinkMap->begin()->second->capturedSeconds();
+	for (auto sinkIter = m_localRtpSinkMap->begin();
+			sinkIter != m_localRtpSinkMap->end(); sinkIter++) {
+		size_t sinkSeconds = sinkIter->second->capturedSeconds();
+		if (sinkSeconds < capturedSeconds)
+			capturedSeconds = sinkSeconds;
+	}
+	return capturedSeconds;
+}
+
+void Call::releaseAudio() {
+	for (auto sinkIter = m_localRtpSinkMap->begin();
+			sinkIter != m_localRtpSinkMap->end(); sinkIter++) {
+		sinkIter->second->deactivate();
+	}
+	m_rtpSinksAreActivated = false;
+
+	// The SipProcessor may still change the local map (re-INVITE).
+	m_releasedRtpSinkMap = make_shared<RtpSinkMapType>(*m_localRtpSinkMap);
+	L_t<< "Audio released, RtpSink objects: " << m_releasedRtpSinkMap->size();
+}
+
 shared_ptr<RtpSinkMapType> Call::getLocalRtpSinkMap() {
 	return m_localRtpSinkMap;
 }
@@ -176,6 +221,8 @@ void Call::setFlagNoRtp() {
 }
 
 std::shared_ptr<RtpSinkMapType> Call::getRtpSinkMap() {
+	if (m_releasedRtpSinkMap)
+		return m_releasedRtpSinkMap;
 	return m_localRtpSinkMap;
 }
 
@@ -31,9 +31,9 @@
 #ifndef CALL_HPP_
 #define CALL_HPP_
 
-#include <map>
 #include "main/CallxTypes.hpp"
 #include "sip.hpp"
+#include <boost/container/small_vector.hpp>
 
 namespace callx {
 
@@ -41,7 +41,22 @@ class Transaction;
 class RtpSink;
 class RtpSinkMap;
 
-typedef std::map<TransactionId, std::shared_ptr<Transaction>> TransactionMap;
+/**
+ * Entry of the transaction table of a Call. Branch hash and method are
+ * kept inline, so a lookup touches the Transaction object only on a hash
+ * match.
+ */
+struct TransactionEntry {
+    size_t branchHash;
+    requestMethodEnum method;
+    std::shared_ptr<Transaction> transaction;
+};
+
+/**
+ * A call almost never has more than a few live transactions, the table
+ * stores up to 4 of them without a heap allocation.
+ */
+typedef boost::container::small_vector<TransactionEntry, 4> TransactionTable;
 
 struct Dialog {
 
@@ -53,8 +68,8 @@ struct Dialog {
     dialogStateEnum state;
     std::string callId;
 
-    SipFromTo caller;
-    SipFromTo callee;
+    SipIdentity caller;
+    SipIdentity callee;
 };
 
 class Call {
@@ -78,10 +93,30 @@ public:
 
     std::shared_ptr<Dialog> getDialog();
 
-    bool findTransaction(const TransactionId&, std::shared_ptr<Transaction>&);
-    bool findInviteTransaction(std::shared_ptr<Transaction>&);
+    /**
+     * Searches the transaction matching branch and method.
+     * @param branchHash Hash of the branch (StringRefHash).
+     * @param branch
+     * @param method
+     * @param transaction Set to the found transaction.
+     * @return True, if found.
+     */
+    bool findTransaction(size_t branchHash, const std::string& branch,
+            requestMethodEnum method, std::shared_ptr<Transaction>&) const;
+    bool findInviteTransaction(std::shared_ptr<Transaction>&) const;
+
+    /**
+     * Inserts the transaction, if there is none with the same id.
+     * @param transaction
+     */
     void insertTransaction(std::shared_ptr<Transaction>);
-    size_t delTransaction(const TransactionId&);
+
+    /**
+     * Deletes this very transaction from the transaction table.
+     * @param transaction
+     * @return Number of deleted transactions (0 or 1).
+     */
+    size_t delTransaction(const std::shared_ptr<Transaction>&);
 
     /**
      * Deactivates all RtpSink objects, if the call is older than <seconds>.
@@ -96,6 +131,20 @@ public:
      */
     int getRtpInactivityTime();
 
+    /**
+     * Returns the seconds of audio captured by the RtpSink objects.
+     * @return Number of seconds captured by the sink with the least audio,
+     * 0 if no RtpSink is available.
+     */
+    int getCapturedSeconds();
+
+    /**
+     * Releases the audio captured so far to the AudioHandler, while the call
+     * itself stays in the CallMap: all RtpSink objects are deactivated and
+     * getRtpSinkMap() returns a copy of the local RtpSinkMap from now on.
+     */
+    void releaseAudio();
+
     /**
      * Returns the local RtpSinkMap as a shared pointer.
      * @return
@@ -110,6 +159,11 @@ public:
     bool rtpSinksAreActivated() const;
     void setFlagNoRtp();
 
+    /**
+     * Returns the RtpSinkMap for the AudioHandler, this is the copy made by
+     * releaseAudio() or the local RtpSinkMap.
+     * @return
+     */
     std::shared_ptr<RtpSinkMapType> getRtpSinkMap();
 
 protected:
@@ -122,8 +176,9 @@ protected:
     // activity Timestamp (steady clock)
     steadyClock::time_point m_activityTs;
 
-    TransactionMap m_transactionMap;
+    TransactionTable m_transactionTable;
     std::shared_ptr<RtpSinkMapType> m_localRtpSinkMap;
+    std::shared_ptr<RtpSinkMapType> m_releasedRtpSinkMap;
     RtpSinkMap *m_rtpSinkMap;
     std::shared_ptr<Dialog> m_dialog;
     bool m_reinviteFlag;
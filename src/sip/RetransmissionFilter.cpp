@@ -0,0 +1,91 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RetransmissionFilter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "RetransmissionFilter.hpp"
+#include "SipPacket.hpp"
+#include <boost/functional/hash.hpp>
+
+using namespace std;
+
+namespace callx {
+
+RetransmissionFilter::RetransmissionFilter(int window)
+        : m_window(window) {
+}
+
+RetransmissionFilter::~RetransmissionFilter() {
+}
+
+size_t RetransmissionFilter::fingerprint(const SipPacket& sipPacket) {
+    size_t seed = 0;
+    boost::hash_combine(seed, sipPacket.getStartLine());
+    boost::hash_combine(seed, sipPacket.getCallId());
+    boost::hash_combine(seed, sipPacket.getCseqNum());
+    boost::hash_combine(seed, static_cast<int>(sipPacket.getCseqMethod()));
+    boost::hash_combine(seed, sipPacket.getBranch());
+
+    // Responses of different forks differ in the To tag only.
+    boost::hash_combine(seed, sipPacket.getTo().tag);
+
+    // Reliable provisional responses (RFC 3262) of one transaction differ
+    // in RSeq and possibly in the SDP answer.
+    const fieldType* rseq = sipPacket.getField("RSEQ");
+    if (rseq) {
+        boost::hash_combine(seed, rseq->second);
+    }
+    boost::string_ref body = sipPacket.getBody();
+    boost::hash_combine(seed, boost::hash_range(body.begin(), body.end()));
+    return seed;
+}
+
+bool RetransmissionFilter::isRetransmission(const SipPacket& sipPacket) {
+    auto now = steadyClock::now();
+    expire(now);
+
+    size_t fp = fingerprint(sipPacket);
+    if (!m_fingerprintMap.insert( { fp, now }).second) {
+        return true;
+    }
+    m_expiryDeque.push_back( { now, fp });
+    return false;
+}
+
+size_t RetransmissionFilter::size() const {
+    return m_fingerprintMap.size();
+}
+
+void RetransmissionFilter::expire(const steadyClock::time_point& now) {
+    while (!m_expiryDeque.empty()
+            && now - m_expiryDeque.front().first > m_window) {
+        m_fingerprintMap.erase(m_expiryDeque.front().second);
+        m_expiryDeque.pop_front();
+    }
+}
+
+} /* namespace callx */
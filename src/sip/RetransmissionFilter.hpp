@@ -0,0 +1,86 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RetransmissionFilter.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef RETRANSMISSIONFILTER_HPP_
+#define RETRANSMISSIONFILTER_HPP_
+
+#include <deque>
+#include <unordered_map>
+#include "main/CallxTypes.hpp"
+
+namespace callx {
+
+class SipPacket;
+
+/**
+ * Recognizes exact retransmissions of SIP messages. Every message is reduced
+ * to a fingerprint (hash of start line, Call ID, CSeq, Via branch, To tag,
+ * RSeq and message body) that is remembered for a configurable time window.
+ * A message whose fingerprint has been seen within the window is a
+ * retransmission.
+ *
+ * The filter is owned by the SipProcessor thread and is not thread-safe.
+ */
+class RetransmissionFilter {
+public:
+
+    /**
+     * @param window Time window in seconds.
+     */
+    RetransmissionFilter(int window);
+
+    virtual ~RetransmissionFilter();
+
+    /**
+     * Tests the SIP packet and remembers its fingerprint.
+     * @param sipPacket Parsed SIP packet.
+     * @return True if the packet is a retransmission.
+     */
+    bool isRetransmission(const SipPacket& sipPacket);
+
+    size_t size() const;
+
+private:
+
+    static size_t fingerprint(const SipPacket& sipPacket);
+
+    void expire(const steadyClock::time_point& now);
+
+    seconds m_window;
+
+    // fingerprint and time of the first sighting
+    std::unordered_map<size_t, steadyClock::time_point> m_fingerprintMap;
+
+    // fingerprints in insertion order, used for the expiry
+    std::deque<std::pair<steadyClock::time_point, size_t>> m_expiryDeque;
+};
+
+} /* namespace callx */
+
+#endif /* RETRANSMISSIONFILTER_HPP_ */
@@ -31,32 +31,137 @@
 #include "SipPacket.hpp"
 #include "network/TlayerPacket.hpp"
 #include "main/callx.hpp"
-#include <boost/regex.hpp>
+#include "container/ShardedHashMap.hpp"
+#include <boost/utility/string_ref.hpp>
 
 using namespace std;
 
 namespace callx {
 
-SipPacket::SipPacket(unique_ptr<TlayerPacket, TlayerPacketRecycler> tlayerPacket)
-        : m_tlayerPacket(move(tlayerPacket)),
-          m_messageType(mt_MALFORMED),
+namespace {
+
+/**
+ * Returns the next space separated token of str and removes it from str.
+ */
+boost::string_ref nextToken(boost::string_ref& str) {
+    while (!str.empty() && str.front() == ' ') {
+        str.remove_prefix(1);
+    }
+    size_t end = str.find(' ');
+    if (end == boost::string_ref::npos) {
+        end = str.size();
+    }
+    boost::string_ref token = str.substr(0, end);
+    str.remove_prefix(end);
+    return token;
+}
+
+/**
+ * Parses the decimal number at the beginning of the next token of str.
+ * Characters following the digits stay in str.
+ */
+bool parseNumber(boost::string_ref& str, u_long& number) {
+    while (!str.empty() && str.front() == ' ') {
+        str.remove_prefix(1);
+    }
+    number = 0;
+    size_t digits = 0;
+    while (digits < str.size() && digits < 10 && isdigit(str[digits])) {
+        number = number * 10 + (str[digits] - '0');
+        digits++;
+    }
+    str.remove_prefix(digits);
+    return digits > 0;
+}
+
+/**
+ * Parses the value of a c= line, e.g. "IN IP4 192.168.1.10" or
+ * "IN IP4 224.2.1.1/127".
+ */
+bool parseConnectionAddress(boost::string_ref value,
+        boost::asio::ip::address& address) {
+    if (nextToken(value) != "IN") {
+        return false;
+    }
+    nextToken(value); // IP4 or IP6
+    boost::string_ref addressStr = nextToken(value);
+    addressStr = addressStr.substr(0, addressStr.find('/'));
+
+    // from_string() needs a terminated string
+    char buffer[64];
+    if (addressStr.empty() || addressStr.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::copy(addressStr.begin(), addressStr.end(), buffer);
+    buffer[addressStr.size()] = '\0';
+
+    boost::system::error_code ec;
+    address = boost::asio::ip::address::from_string(buffer, ec);
+    return !ec;
+}
+
+} /* namespace */
+
+SipPacket::SipPacket()
+        : m_messageType(mt_MALFORMED),
           m_requestMethod(rm_UNDEFINED),
           m_responseStatusCode(0),
+          m_callIdHash(0),
           m_cseqMethod(rm_UNDEFINED),
           m_seqNum(0),
+          m_branchHash(0),
           m_sentByProtocol(tp_UNDEFINED),
-          m_hasSdpPayload(false) {
+          m_hasSdpPayload(false),
+          m_sdpOffset(0) {
 
 }
 
 SipPacket::~SipPacket() {
 }
 
-bool SipPacket::parse() {
+void SipPacket::fill(
+        unique_ptr<TlayerPacket, TlayerPacketRecycler> tlayerPacket) {
 
+    // tlayerPacket goes back to the TlayerPacketQueue on return
     m_sipRawString.assign(
-            reinterpret_cast<char*>(m_tlayerPacket->m_udpPacket.payload),
-            m_tlayerPacket->m_udpPacket.payloadLen);
+            reinterpret_cast<char*>(tlayerPacket->m_udpPacket.payload),
+            tlayerPacket->m_udpPacket.payloadLen);
+}
+
+void SipPacket::clear() {
+
+    // clear() keeps the capacity of strings and field lists
+    m_sipRawString.clear();
+    m_startLine.clear();
+    m_sipFields.clear();
+    m_messageType = mt_MALFORMED;
+    m_requestMethod = rm_UNDEFINED;
+    m_requestUri.clear();
+    m_responseStatusCode = 0;
+    m_responseReason.clear();
+    m_hasFields = HasFields();
+    m_callId.clear();
+    m_callIdHash = 0;
+    m_fromString.clear();
+    m_toString.clear();
+    m_from.tag.clear();
+    m_from.address.clear();
+    m_from.displayname.clear();
+    m_to.tag.clear();
+    m_to.address.clear();
+    m_to.displayname.clear();
+    m_cseqMethod = rm_UNDEFINED;
+    m_seqNum = 0;
+    m_branch.clear();
+    m_branchHash = 0;
+    m_sentBy.clear();
+    m_sentByProtocol = tp_UNDEFINED;
+    m_hasSdpPayload = false;
+    m_sdpOffset = 0;
+    m_sdpMediaStreams.clear();
+}
+
+bool SipPacket::parse() {
 
     if (parseSip()) {
 
@@ -77,47 +182,61 @@ bool SipPacket::parse() {
 
 bool SipPacket::parseSip() {
 
-    string line; // one line of our SIP packet
-    boost::cmatch matches; // regex_match() result
-
-    // end of line is CRLF
-    const boost::regex sipLineDelim("\r\n");
+    // The regular expressions are compiled once and shared by all
+    // SipPacket objects, matching against a const regex is thread-safe.
 
     // Method SP Request-URI SP SIP-Version
-    const boost::regex sipRequest("(^\\w+?) (.*) SIP/2\\.0$",
+    static const boost::regex sipRequest("(^\\w+?) (.*) SIP/2\\.0$",
             boost::regex_constants::icase);
 
     // SIP-Version SP Status-Code SP Reason-Phrase
-    const boost::regex sipResponse("^SIP/2\\.0 (\\d{3}) (.+)",
+    static const boost::regex sipResponse("^SIP/2\\.0 (\\d{3}) (.+)",
             boost::regex_constants::icase);
 
     // field-name:field-value
-    const boost::regex sipFieldAndValue("^(.+?)\\s*:\\s*(.+)");
+    static const boost::regex sipFieldAndValue("^(.+?)\\s*:\\s*(.+)");
 
-    // field-name=field-value
-    const boost::regex sdpFieldAndValue("^(.)\\s*=\\s*(.+)");
+    //*******************************
+    // regex for e.g.: "PhonerLite" <sip:tel_20@192.168.11.107>;tag=as008e599f
+    // (([ display-name ] LAQUOT SIP-URI RAQUOT) / SIP-URI )*( SEMI "tag" EQUAL token )
+    // RFC3261 par. 25 for details
+    static const boost::regex fromAndToRegex(
+            "(\\\"?(.+?)\\\"?)?\\s*(<(.+?)(;.*)?>)\\s*(;tag=(.*))?" /*, boost::regex_constants::icase*/);
+    //*******************************
+
+    // CSeq is: <32bit-number> <space> <method>
+    static const boost::regex cSeqRegex("(\\d+)\\s+(\\w+)");
 
-    // line iterator
-    boost::sregex_token_iterator lineIter(m_sipRawString.begin(),
-            m_sipRawString.end(), sipLineDelim, -1);
-    boost::sregex_token_iterator nullIter;
+    // This regex supports comma separated VIA lists
+    static const boost::regex branchRegex(
+            "^SIP/2\\.0/(UDP|TCP)\\s(.*?);branch=([^,]+?)((;|,).*)?|$");
 
     // no data
-    if (lineIter == nullIter)
+    if (m_sipRawString.empty())
         return false;
 
+    // Lines end with CRLF. The lines are matched in place, an empty line
+    // at the end of the data is no line of its own.
+    const char *data = m_sipRawString.data();
+    size_t dataLen = m_sipRawString.size();
+    size_t lineBegin = 0;
+    size_t lineEnd = m_sipRawString.find("\r\n");
+    if (lineEnd == string::npos) {
+        lineEnd = dataLen;
+    }
+
     // handle startline
-    m_startLine = *lineIter;
+    m_startLine.assign(data, lineEnd);
 
     L_i
     << m_startLine;
 
     // test for SIP request
-    if (boost::regex_match(m_startLine.c_str(), matches, sipRequest)) {
-        if (matches.size() == 3) {
+    if (boost::regex_match(m_startLine.c_str(), m_matches, sipRequest)) {
+        if (m_matches.size() == 3) {
             m_messageType = mt_REQUEST;
-            string requestMethod(matches[1].first, matches[1].second);
-            m_requestUri.assign(matches[2].first, matches[2].second);
+            string requestMethod(m_matches[1].first, m_matches[1].second);
+            m_requestUri.assign(m_matches[2].first, m_matches[2].second);
 
             m_requestMethod = requestToEnum(requestMethod);
 
@@ -128,14 +247,13 @@ bool SipPacket::parseSip() {
     }
 
     // test for SIP response
-    else if (boost::regex_match(m_startLine.c_str(), matches, sipResponse)) {
-        if (matches.size() == 3) {
+    else if (boost::regex_match(m_startLine.c_str(), m_matches, sipResponse)) {
+        if (m_matches.size() == 3) {
             m_messageType = mt_RESPONSE;
-            string tempStr(matches[1].first, matches[1].second);
 
             // input is regex match \d{3}
-            m_responseStatusCode = strtol(tempStr.c_str(), NULL, 10);
-            m_responseReason.assign(matches[2].first, matches[2].second);
+            m_responseStatusCode = strtol(m_matches[1].first, NULL, 10);
+            m_responseReason.assign(m_matches[2].first, m_matches[2].second);
 
             L_t
             << "Response, status: " << m_responseStatusCode << " " << m_responseReason;
@@ -143,42 +261,33 @@ bool SipPacket::parseSip() {
     }
 
     // handle next lines
+    while (lineEnd + 2 < dataLen) {
+        lineBegin = lineEnd + 2;
+        lineEnd = m_sipRawString.find("\r\n", lineBegin);
+        if (lineEnd == string::npos) {
+            lineEnd = dataLen;
+        }
 
-    // This regex changes later to &sdpFieldAndValue (if SDP existent)
-    const boost::regex *fieldAndValue = &sipFieldAndValue;
-
-    // later &sdpFieldMap if SDP existent
-    fieldMapType *fieldMap = &m_sipFieldMap;
-
-    while (++lineIter != nullIter) {
-        line = *lineIter;
-
-        // SIP->SDP context switch:
-        // SIP body (SDP) follows after empty line (RFC 3261)
-        if (line.empty()) {
-
-            // switching context from SIP to SDP and continue loop
-            fieldAndValue = &sdpFieldAndValue;
-            fieldMap = &m_sdpFieldMap;
-            continue;
+        // SIP body (SDP) follows after empty line (RFC 3261), it is
+        // parsed by parseSdp().
+        if (lineBegin == lineEnd) {
+            m_sdpOffset = lineEnd + 2;
+            break;
         }
 
         // do the regex
-        if (regex_match(line.c_str(), matches, *fieldAndValue)) {
-            if (matches.size() == 3) {
-                string matchFieldName(matches[1].first, matches[1].second);
-                string matchFieldValue(matches[2].first, matches[2].second);
-
-                // transforming to upper-case if we are in SIP *header*
-                // not if we are in SIP body, SDP is case-significant
-                if (fieldMap == &m_sipFieldMap) {
-                    transform(matchFieldName.begin(), matchFieldName.end(),
-                            matchFieldName.begin(), ptr_fun(::toupper));
-                }
-
-                // inserting in SIP or SDP fieldmap
-                fieldMap->insert(
-                        pair<string, string>(matchFieldName, matchFieldValue));
+        if (boost::regex_match(data + lineBegin, data + lineEnd, m_matches,
+                sipFieldAndValue)) {
+            if (m_matches.size() == 3) {
+
+                // inserting in SIP field list
+                fieldType& field = m_sipFields.add();
+                field.first.assign(m_matches[1].first, m_matches[1].second);
+                field.second.assign(m_matches[2].first, m_matches[2].second);
+
+                // field names are case-insensitive
+                transform(field.first.begin(), field.first.end(),
+                        field.first.begin(), ptr_fun(::toupper));
             }
         }
     }
@@ -188,79 +297,73 @@ bool SipPacket::parseSip() {
      * Some parts may not be present.
      */
 
-    // find iterator
-    fieldMapType::const_iterator findIter;
-
-    //*******************************
-    // regex for e.g.: "PhonerLite" <sip:tel_20@192.168.11.107>;tag=as008e599f
-    // (([ display-name ] LAQUOT SIP-URI RAQUOT) / SIP-URI )*( SEMI "tag" EQUAL token )
-    // RFC3261 par. 25 for details
-    boost::regex fromAndToRegex(
-            "(\\\"?(.+?)\\\"?)?\\s*(<(.+?)(;.*)?>)\\s*(;tag=(.*))?" /*, boost::regex_constants::icase*/);
-    //*******************************
+    // find result
+    const fieldType *field;
 
     // SIP From
-    findIter = m_sipFieldMap.find("FROM");
-    if (findIter != m_sipFieldMap.end()) {
+    field = m_sipFields.find("FROM");
+    if (field) {
         m_hasFields.from = true;
-        m_fromString = findIter->second;
+        m_fromString = field->second;
         L_i
         << "From: " << m_fromString;
 
         // extract display name, from address, from tag
-        boost::regex_match(findIter->second.c_str(), matches, fromAndToRegex);
+        if (boost::regex_match(field->second.c_str(), m_matches,
+                fromAndToRegex)) {
 
-        // match[1] is display name with possible double quotes
-        m_from.displayname.assign(matches[2].first, matches[2].second);
+            // match[1] is display name with possible double quotes
+            m_from.displayname.assign(m_matches[2].first, m_matches[2].second);
 
-        // match[3] is source address with left and right angle brackets
-        m_from.address.assign(matches[4].first, matches[4].second);
-
-        m_from.tag.assign(matches[7].first, matches[7].second);
+            // match[3] is source address with left and right angle brackets
+            m_from.address.assign(m_matches[4].first, m_matches[4].second);
 
+            m_from.tag.assign(m_matches[7].first, m_matches[7].second);
+        }
     }
 
     // SIP To
-    findIter = m_sipFieldMap.find("TO");
-    if (findIter != m_sipFieldMap.end()) {
+    field = m_sipFields.find("TO");
+    if (field) {
         m_hasFields.to = true;
-        m_toString = findIter->second;
+        m_toString = field->second;
         L_i
         << "To: " << m_toString;
+
         // extract display name, to address, to tag
-        boost::regex_match(findIter->second.c_str(), matches, fromAndToRegex);
+        if (boost::regex_match(field->second.c_str(), m_matches,
+                fromAndToRegex)) {
 
-        // match[1] is display name with possible double quotes
-        m_to.displayname.assign(matches[2].first, matches[2].second);
+            // match[1] is display name with possible double quotes
+            m_to.displayname.assign(m_matches[2].first, m_matches[2].second);
 
-        // match[3] is destination address with left and right angle brackets
-        m_to.address.assign(matches[4].first, matches[4].second);
+            // match[3] is destination address with left and right angle brackets
+            m_to.address.assign(m_matches[4].first, m_matches[4].second);
 
-        m_to.tag.assign(matches[7].first, matches[7].second);
+            m_to.tag.assign(m_matches[7].first, m_matches[7].second);
+        }
     }
 
     // SIP Call ID
-    findIter = m_sipFieldMap.find("CALL-ID");
-    if (findIter != m_sipFieldMap.end()) {
+    field = m_sipFields.find("CALL-ID");
+    if (field) {
         m_hasFields.callId = true;
-        m_callId = findIter->second;
+        m_callId = field->second;
+        m_callIdHash = StringRefHash()(m_callId);
         L_t
         << "Call ID: " << m_callId;
     }
 
     // SIP CSeq Number & Method
-    findIter = m_sipFieldMap.find("CSEQ");
-    if (findIter != m_sipFieldMap.end()) {
+    field = m_sipFields.find("CSEQ");
+    if (field) {
         m_hasFields.cSeq = true;
 
-        // CSeq is: <32bit-number> <space> <method>
-        boost::regex cSeqRegex("(\\d+)\\s+(\\w+)");
-        if (regex_match(findIter->second.c_str(), matches, cSeqRegex)) {
+        if (boost::regex_match(field->second.c_str(), m_matches, cSeqRegex)) {
 
-            string number(matches[1].first, matches[1].second);
-            m_seqNum = strtoul(number.c_str(), NULL, 10);
+            m_seqNum = strtoul(m_matches[1].first, NULL, 10);
 
-            string method(matches[2].first, matches[2].second);
+            string method(m_matches[2].first, m_matches[2].second);
             m_cseqMethod = requestToEnum(method);
 
             L_t
@@ -269,24 +372,23 @@ bool SipPacket::parseSip() {
         }
     }
 
-    // SIP branch, sent-by
-    findIter = m_sipFieldMap.lower_bound("VIA");
-    if (findIter != m_sipFieldMap.end()) {
+    // SIP branch, sent-by (topmost Via)
+    field = m_sipFields.find("VIA");
+    if (field) {
 
-        // This regex supports comma separated VIA lists
-        boost::regex branchRegex(
-                "^SIP/2\\.0/(UDP|TCP)\\s(.*?);branch=([^,]+?)((;|,).*)?|$");
-        if (regex_match(findIter->second.c_str(), matches, branchRegex)) {
+        if (boost::regex_match(field->second.c_str(), m_matches,
+                branchRegex)) {
 
             // transport protocol
-            string protocol(matches[1].first, matches[1].second);
+            string protocol(m_matches[1].first, m_matches[1].second);
             m_sentByProtocol = transportProtoStringToEnum(protocol);
 
             // sent-by
-            m_sentBy.assign(matches[2].first, matches[2].second);
+            m_sentBy.assign(m_matches[2].first, m_matches[2].second);
 
             // branch
-            m_branch.assign(matches[3].first, matches[3].second);
+            m_branch.assign(m_matches[3].first, m_matches[3].second);
+            m_branchHash = StringRefHash()(m_branch);
 
             L_t
             << "Branch: " << m_branch;
@@ -294,16 +396,15 @@ bool SipPacket::parseSip() {
     }
 
     // SIP Max-Fowards
-    findIter = m_sipFieldMap.find("MAX-FORWARDS");
-    if (findIter != m_sipFieldMap.end()) {
+    field = m_sipFields.find("MAX-FORWARDS");
+    if (field) {
         m_hasFields.maxForwards = true;
     }
 
     // Test if SDP payload available
     m_hasSdpPayload = false;
-    findIter = m_sipFieldMap.find("CONTENT-TYPE");
-    if (findIter != m_sipFieldMap.end()
-            && findIter->second == "application/sdp") {
+    field = m_sipFields.find("CONTENT-TYPE");
+    if (field && field->second == "application/sdp") {
         m_hasSdpPayload = true;
     }
 
@@ -311,41 +412,110 @@ bool SipPacket::parseSip() {
 }
 
 bool SipPacket::parseSdp() {
-    boost::cmatch matches;
 
-    // regex that matches port and payloadtypes in e.g.:
-    // audio 12692 RTP/AVP 8 3 0 112 5 10 7 110 111 101
-    boost::regex portRegex("audio (\\d{4,5}) RTP/AVP( \\d{1,3})+");
+    // session level connection address and ptime, defaults for all media
+    // streams without own c= or a=ptime line
+    boost::asio::ip::address sessionAddress;
+    u_int sessionPtime = 0;
+
+    // current media stream, NULL on session level
+    SdpMediaStream *stream = NULL;
+
+    // SDP body, one line per <type>=<value>
+    boost::string_ref sdp(m_sipRawString.data() + m_sdpOffset,
+            m_sipRawString.size() - m_sdpOffset);
 
-    // parsing SDP
-    for (fieldMapType::const_iterator sdpIter = m_sdpFieldMap.begin();
-            sdpIter != m_sdpFieldMap.end(); sdpIter++) {
+    while (!sdp.empty()) {
 
-        // get IP
-        if (sdpIter->first == "c" && sdpIter->second.find("IN IP") == 0) {
-            m_sdpSocketAddress.setIpAddress(
-                    boost::asio::ip::address::from_string(
-                            sdpIter->second.substr(7).c_str()));
+        // Lines end with CRLF, a single LF is tolerated.
+        size_t lineEnd = sdp.find('\n');
+        boost::string_ref line = sdp.substr(0, lineEnd);
+        sdp.remove_prefix(
+                lineEnd == boost::string_ref::npos ? sdp.size() : lineEnd + 1);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        if (line.size() < 2 || line[1] != '=') {
+            continue;
         }
-        // get port
-        if (sdpIter->first == "m") {
-            if (boost::regex_match(sdpIter->second.c_str(), matches,
-                    portRegex)) {
+        boost::string_ref value = line.substr(2);
 
-                // convert port
-                string tempStr(matches[1].first, matches[1].second);
-                unsigned short port = StringToNumber<unsigned short>(tempStr);
+        switch (line[0]) {
+
+        // m=<media> <port>[/<number of ports>] <proto> <fmt> ...
+        case 'm': {
+            m_sdpMediaStreams.emplace_back();
+            stream = &m_sdpMediaStreams.back();
+            boost::string_ref media = nextToken(value);
+            stream->media.assign(media.data(), media.size());
+            stream->ptime = sessionPtime;
+
+            u_long port;
+            if (!parseNumber(value, port) || port > 65535) {
 
                 // abort on bogus port number.
-                if (port == 0 || port > 65535)
-                    return false;
-                m_sdpSocketAddress.setPort(port);
+                return false;
+            }
+            stream->socketAddress.setData(sessionAddress, port, tp_UDP);
+            break;
+        }
+
+        // c=<nettype> <addrtype> <connection-address>[/<ttl>]
+        case 'c': {
+            boost::asio::ip::address address;
+            if (!parseConnectionAddress(value, address)) {
+
+                // The stream keeps the session level or unspecified
+                // address, no RtpSink is created for the latter.
+                L_t
+                << "SDP connection address not supported: " << line;
+                break;
+            }
+            if (stream) {
+                stream->socketAddress.setIpAddress(address);
+            } else {
+                sessionAddress = address;
+            }
+            break;
+        }
+
+        // a=rtpmap:<payload type> <encoding name>/<clock rate>[/<params>]
+        // a=ptime:<packet time>
+        case 'a': {
+            u_long number;
+            if (value.starts_with("rtpmap:")) {
+                value.remove_prefix(7);
+                if (stream && parseNumber(value, number) && number < 128) {
+                    boost::string_ref encoding = nextToken(value);
+                    encoding = encoding.substr(0, encoding.find('/'));
+                    stream->payloadTypeMap.setCodec(number,
+                            audioCodecNameToEnum(encoding.data(),
+                                    encoding.size()));
+                }
+            } else if (value.starts_with("ptime:")) {
+                value.remove_prefix(6);
+                if (parseNumber(value, number)) {
+                    if (stream) {
+                        stream->ptime = number;
+                    } else {
+                        sessionPtime = number;
+                    }
+                }
             }
+            break;
+        }
+
+        default:
+            break;
         }
     }
-    m_sdpSocketAddress.setTransportProto(tp_UDP);
-    L_t
-    << "SDP socket address: " << m_sdpSocketAddress;
+
+    for (auto iter = m_sdpMediaStreams.begin();
+            iter != m_sdpMediaStreams.end(); iter++) {
+        L_t
+        << "SDP media stream: " << iter->media << " " << iter->socketAddress;
+    }
     return true;
 }
 
@@ -373,10 +543,18 @@ requestMethodEnum SipPacket::requestToEnum(const string& request) const {
     return rm_UNDEFINED;
 }
 
+const string& SipPacket::getStartLine() const {
+    return m_startLine;
+}
+
 const string& SipPacket::getCallId() const {
     return m_callId;
 }
 
+size_t SipPacket::getCallIdHash() const {
+    return m_callIdHash;
+}
+
 const string& SipPacket::getRequestUri() const {
     return m_requestUri;
 }
@@ -401,6 +579,10 @@ const string& SipPacket::getBranch() const {
     return m_branch;
 }
 
+size_t SipPacket::getBranchHash() const {
+    return m_branchHash;
+}
+
 const string& SipPacket::getSentBy() const {
     return m_sentBy;
 }
@@ -421,6 +603,18 @@ messageTypeEnum SipPacket::getMessageType() const {
     return m_messageType;
 }
 
+const fieldType* SipPacket::getField(const char* field) const {
+    return m_sipFields.find(field);
+}
+
+boost::string_ref SipPacket::getBody() const {
+    if (m_sdpOffset == 0) {
+        return boost::string_ref();
+    }
+    return boost::string_ref(m_sipRawString.data() + m_sdpOffset,
+            m_sipRawString.size() - m_sdpOffset);
+}
+
 responseCodeEnum SipPacket::getResponseCategory() const {
     if (m_responseStatusCode >= 100 && m_responseStatusCode <= 199)
         return rc_PROVISIONAL;
@@ -445,8 +639,8 @@ const string& SipPacket::getResponseReason() const {
     return m_responseReason;
 }
 
-const SocketAddress& SipPacket::getSdpMediaSocket() const {
-    return m_sdpSocketAddress;
+const vector<SdpMediaStream>& SipPacket::getSdpMediaStreams() const {
+    return m_sdpMediaStreams;
 }
 
 requestMethodEnum SipPacket::getRequestMethod() const {
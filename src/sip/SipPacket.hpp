@@ -33,7 +33,11 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <boost/regex.hpp>
+#include <boost/utility/string_ref.hpp>
 #include "sip.hpp"
+#include "audio/audio.hpp"
 #include "network/SocketAddress.hpp"
 #include "network/TlayerPacketRecycler.hpp"
 #include "network/TlayerPacket.hpp"
@@ -41,7 +45,78 @@
 namespace callx {
 
 // pair of <field> and <value>
-typedef std::multimap<std::string, std::string> fieldMapType;
+typedef std::pair<std::string, std::string> fieldType;
+
+/**
+ * List of <field> and <value> pairs in order of appearance. clear() only
+ * resets the fill level, the strings keep their buffers for the next
+ * SIP message.
+ */
+class FieldList {
+public:
+
+    typedef std::vector<fieldType>::const_iterator const_iterator;
+
+    FieldList()
+            : m_size(0) {
+    }
+
+    /**
+     * Returns the next unused pair, its strings may hold old values.
+     */
+    fieldType& add() {
+        if (m_size == m_fields.size()) {
+            m_fields.emplace_back();
+        }
+        return m_fields[m_size++];
+    }
+
+    /**
+     * Returns the first pair with the given field name or nullptr.
+     */
+    const fieldType* find(const char* field) const {
+        for (size_t i = 0; i < m_size; i++) {
+            if (m_fields[i].first == field) {
+                return &m_fields[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const_iterator begin() const {
+        return m_fields.begin();
+    }
+
+    const_iterator end() const {
+        return m_fields.begin() + m_size;
+    }
+
+    void clear() {
+        m_size = 0;
+    }
+
+private:
+    std::vector<fieldType> m_fields;
+    size_t m_size;
+};
+
+/**
+ * One media description (m= line) of a session description.
+ */
+struct SdpMediaStream {
+
+    // media type, e.g. "audio" or "video"
+    std::string media;
+
+    // connection address (media or session level c= line) and port
+    SocketAddress socketAddress;
+
+    // RTP payload type to codec mapping
+    PayloadTypeMap payloadTypeMap;
+
+    // packetization time from a=ptime in milliseconds, 0 if not present
+    u_int ptime;
+};
 
 class SipPacket {
 public:
@@ -49,23 +124,49 @@ public:
     /**
      * Standard constructor
      */
-    SipPacket(std::unique_ptr<TlayerPacket, TlayerPacketRecycler>);
+    SipPacket();
 
     /**
      * Destructor
      */
     virtual ~SipPacket();
 
+    /**
+     * Copy the SIP message out of the TlayerPacket. The TlayerPacket is
+     * returned to its repository when fill() returns, so queued SIP
+     * messages do not hold TlayerPacket objects needed for RTP.
+     * @param tlayerPacket
+     */
+    void fill(std::unique_ptr<TlayerPacket, TlayerPacketRecycler> tlayerPacket);
+
+    /**
+     * Reset all parse results. Strings and field lists keep their
+     * capacity, so a recycled SipPacket parses the next message without
+     * allocating.
+     */
+    void clear();
+
     bool parse();
     bool hasSdpPayload();
 
+    const std::string& getStartLine() const;
     const std::string& getCallId() const;
+
+    /**
+     * Hash of the Call-ID (StringRefHash), computed once while parsing.
+     */
+    size_t getCallIdHash() const;
     const std::string& getRequestUri() const;
     const std::string& getFromString() const;
     const std::string& getToString() const;
     const SipFromTo& getFrom() const;
     const SipFromTo& getTo() const;
     const std::string& getBranch() const;
+
+    /**
+     * Hash of the Via branch (StringRefHash), computed once while parsing.
+     */
+    size_t getBranchHash() const;
     const std::string& getSentBy() const;
     const transportProtoEnum getSentByProtocol() const;
     requestMethodEnum getCseqMethod() const;
@@ -75,7 +176,17 @@ public:
     responseCodeEnum getResponseCategory() const;
     u_int getResponseCode() const;
     const std::string& getResponseReason() const;
-    const SocketAddress& getSdpMediaSocket() const;
+    const std::vector<SdpMediaStream>& getSdpMediaStreams() const;
+
+    /**
+     * Returns the first field with the given (upper case) name or nullptr.
+     */
+    const fieldType* getField(const char* field) const;
+
+    /**
+     * Message body behind the empty line, empty if there is none.
+     */
+    boost::string_ref getBody() const;
 
 private:
 
@@ -84,17 +195,14 @@ private:
 
     requestMethodEnum requestToEnum(const std::string& request) const;
 
-    // Layer 4 packet
-    std::unique_ptr<TlayerPacket, TlayerPacketRecycler> m_tlayerPacket;
-
-    // This string takes the raw SIP data.
+    // This string takes the raw SIP data (UDP payload).
     std::string m_sipRawString;
 
     // SIP start line
     std::string m_startLine;
 
     // SIP attribute value pairs
-    fieldMapType m_sipFieldMap;
+    FieldList m_sipFields;
 
     // SIP message type (request / response)
     messageTypeEnum m_messageType;
@@ -129,6 +237,7 @@ private:
     } m_hasFields;
 
     std::string m_callId;
+    size_t m_callIdHash;
     std::string m_fromString;
     std::string m_toString;
     SipFromTo m_from;
@@ -136,17 +245,21 @@ private:
     requestMethodEnum m_cseqMethod;
     u_int m_seqNum;
     std::string m_branch;
+    size_t m_branchHash;
     std::string m_sentBy;
     transportProtoEnum m_sentByProtocol;
 
     // SDP payload available?
     bool m_hasSdpPayload;
 
-    // SDP attribute value pairs
-    fieldMapType m_sdpFieldMap;
+    // offset of the SDP body in m_sipRawString
+    size_t m_sdpOffset;
+
+    // SDP media streams in order of their m= lines
+    std::vector<SdpMediaStream> m_sdpMediaStreams;
 
-    // SDP Socket Address
-    SocketAddress m_sdpSocketAddress;
+    // regex_match() results, reused for every match
+    boost::cmatch m_matches;
 };
 
 } /* namespace callx */
@@ -0,0 +1,64 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SipPacketRecycler.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SIPPACKETRECYCLER_HPP_
+#define SIPPACKETRECYCLER_HPP_
+
+#include "container/SipPacketRepository.hpp"
+#include "sip/SipPacket.hpp"
+#include "main/callx.hpp"
+
+namespace callx {
+
+class SipPacketRecycler {
+public:
+
+    SipPacketRecycler()
+            : m_sipPacketRepository(SipPacketRepository::getInstance()) {
+    }
+
+    void operator()(SipPacket* sipPacket) {
+
+        // Recycling is only possible if there is a SipPacket object.
+        if (sipPacket) {
+
+            // Reset the parse results, but keep the buffers for the next
+            // SIP message.
+            sipPacket->clear();
+            m_sipPacketRepository->push(
+                    std::unique_ptr<SipPacket, SipPacketRecycler>(sipPacket));
+        }
+    }
+
+private:
+    SipPacketRepository *m_sipPacketRepository;
+};
+
+} /* namespace callx */
+#endif /* SIPPACKETRECYCLER_HPP_ */
@@ -36,12 +36,18 @@
 #include "container/CallMap.hpp"
 #include "container/CallDecodeQueue.hpp"
 #include "container/SbaIncidentMap.hpp"
+#include "container/SbaEventMap.hpp"
+#include "container/OodTransactionMap.hpp"
+#include "container/InternPool.hpp"
 #include "Transaction.hpp"
+#include "RetransmissionFilter.hpp"
 
 using namespace std;
 
 namespace callx {
 
+u_int SipProcessor::sipRetransmissionCount = 0;
+
 /*
  * Constructor of the SipProcessor.
  */
@@ -53,6 +59,11 @@ SipProcessor::SipProcessor() {
 	m_rtpSinkMap = RtpSinkMap::getInstance();
 	m_callDecodeQueue = CallDecodeQueue::getInstance();
 	m_sbaIncidentMap = SbaIncidentMap::getInstance();
+	m_sbaEventMap = SbaEventMap::getInstance();
+	m_oodTransactionMap = OodTransactionMap::getInstance();
+	m_internPool = InternPool::getInstance();
+	m_retransmissionFilter.reset(new RetransmissionFilter(
+					m_callxConfig->sip_retransmission_window));
 }
 
 SipProcessor::~SipProcessor() {
@@ -100,12 +111,27 @@ void SipProcessor::worker() {
 			continue;
 		}
 
+		// Discard exact retransmissions before any state handling.
+		if (m_retransmissionFilter->isRetransmission(*m_currPacket)) {
+			SipProcessor::sipRetransmissionCount++;
+			L_t<< "Discarding retransmission. Call ID: "
+			<< m_currPacket->getCallId();
+			continue;
+		}
+
+		// Out-of-dialog OPTIONS and REGISTER transactions are tracked
+		// without a Call object.
+		if (handleOutOfDialog()) {
+			continue;
+		}
+
 		// ------------------------------------------------
 		// CALL HANDLING                                -->
 		// ------------------------------------------------
 
 		// Searching Call object in CallMap
-		if (m_callMap->find(m_currPacket->getCallId(), m_currCall)) {
+		if (m_callMap->find(m_currPacket->getCallIdHash(),
+				m_currPacket->getCallId(), m_currCall)) {
 
 			// Call exists.
 			L_t<< "Found call in CallMap.";
@@ -120,8 +146,7 @@ void SipProcessor::worker() {
 			<< "Call not in CallMap.";
 
 			if (m_currPacket->getMessageType() == mt_REQUEST
-					&& (m_currPacket->getRequestMethod() == rm_INVITE
-							|| m_currPacket->getRequestMethod() == rm_OPTIONS)) {
+					&& m_currPacket->getRequestMethod() == rm_INVITE) {
 				L_t
 				<< "Request is "
 				<< requestMethodEnumToString(m_currPacket
@@ -143,8 +168,9 @@ void SipProcessor::worker() {
 				}
 				m_currDialog = m_currCall->getDialog();
 				m_currCallLock = m_currCall->getUniqueLock();
-				m_callMap->insert(make_pair(m_currPacket->getCallId(),
-								m_currCall));
+				m_callMap->insert(m_currPacket->getCallIdHash(),
+						m_currPacket->getCallId(), m_currCall);
+				m_callMap->scheduleCallTimeouts(m_currCall);
 			} else {
 				L_i
 				<< "Discarding SIP Message. Call ID: "
@@ -164,11 +190,13 @@ void SipProcessor::worker() {
 		// What about the transaction?
 		// Matches if Branch and cSeqMethod are equal and also matches
 		// if we have an ACK on NON-SUCCESS
-		if (m_currCall->findTransaction( { m_currPacket->getBranch(),
-				m_currPacket->getCseqMethod() }, m_currTransaction)
+		if (m_currCall->findTransaction(m_currPacket->getBranchHash(),
+				m_currPacket->getBranch(), m_currPacket->getCseqMethod(),
+				m_currTransaction)
 				|| (m_currPacket->getCseqMethod() == rm_ACK
 						&& m_currCall->findTransaction(
-								{ m_currPacket->getBranch(), rm_INVITE },
+								m_currPacket->getBranchHash(),
+								m_currPacket->getBranch(), rm_INVITE,
 								m_currTransaction))) {
 
 			L_t<< "Found transaction.";
@@ -216,10 +244,74 @@ void SipProcessor::worker() {
 	m_stopped = true;
 }
 
+bool SipProcessor::handleOutOfDialog() {
+
+	requestMethodEnum method = m_currPacket->getCseqMethod();
+	if (method != rm_OPTIONS && method != rm_REGISTER) {
+		return false;
+	}
+
+	if (m_currPacket->getMessageType() == mt_REQUEST) {
+
+		// An OPTIONS request with a To tag is sent within a dialog and
+		// belongs to a Call. REGISTER never creates a dialog.
+		if (method == rm_OPTIONS && !m_currPacket->getTo().tag.empty()) {
+			return false;
+		}
+
+		if (!m_oodTransactionMap->insert(*m_currPacket)) {
+			L_t<< "Retransmission of an out-of-dialog "
+			<< requestMethodEnumToString(method)
+			<< " request. Call ID: "
+			<< m_currPacket->getCallId();
+			return true;
+		}
+
+		if (method == rm_OPTIONS) {
+			pushOptionsEvent(m_currPacket->getCallId(),
+					m_internPool->intern(m_currPacket->getFrom()), 0, "");
+		}
+		return true;
+	}
+
+	// SIP response: does it match an out-of-dialog transaction?
+	OodTransaction transaction;
+	if (!m_oodTransactionMap->find(*m_currPacket, transaction)) {
+
+		// It may be a response within a dialog.
+		return false;
+	}
+
+	// Nothing to do until the final response arrives.
+	if (m_currPacket->getResponseCategory() == rc_PROVISIONAL) {
+		return true;
+	}
+
+	m_oodTransactionMap->erase(*m_currPacket);
+
+	if (transaction.method == rm_OPTIONS) {
+		pushOptionsEvent(transaction.callId, transaction.initiator,
+				m_currPacket->getResponseCode(),
+				m_currPacket->getResponseReason());
+	}
+	return true;
+}
+
+void SipProcessor::pushOptionsEvent(const std::string& callId,
+		const SipIdentity& initiator, u_int finalResponseCode,
+		const std::string& finalResponseReason) {
+
+	// There is no dialog, the initiator of the transaction is the caller.
+	OptionsEvent* event = new OptionsEvent(callId, initiator, initiator);
+	event->finalResponseCode = finalResponseCode;
+	event->finalResponseReason = finalResponseReason;
+	m_sbaEventMap->pushEvent(initiator.address, shared_ptr<SbaEvent>(event));
+}
+
 void SipProcessor::handleInitialRequest() {
 
 	// Create Transaction object.
-	m_currTransaction = make_shared<Transaction>(m_currCall, m_currPacket);
+	m_currTransaction = Transaction::create(m_currCall, m_currPacket);
 
 	// These requests initiate a Transaction.
 	switch (m_currPacket->getRequestMethod()) {
@@ -304,15 +396,16 @@ void SipProcessor::handleInvite() {
 		m_currDialog->state = ds_INIT;
 
 		// fill in caller & callee information in Dialog
-		m_currDialog->caller = m_currPacket->getFrom();
-		m_currDialog->callee = m_currPacket->getTo();
+		m_currDialog->caller = m_internPool->intern(m_currPacket->getFrom());
+		m_currDialog->callee = m_internPool->intern(m_currPacket->getTo());
 	}
 
 	// set transaction state
 	m_currTransaction->setState( {ts_CALLING, ts_PROCEEDING});
 
-	// insert transaction into TransactionMap object
+	// insert transaction into the transaction table of the call
 	m_currCall->insertTransaction(m_currTransaction);
+	m_callMap->scheduleTransactionTimeout(m_currCall, m_currTransaction);
 	m_currDialog->state = ds_INIT;
 
 	// Handle session description (create RTP sinks).
@@ -328,8 +421,9 @@ void SipProcessor::handleBye() {
 	// set initial state of transaction
 	m_currTransaction->setState( { ts_TRYING, ts_TRYING });
 
-	// insert transaction into TransactionMap object
+	// insert transaction into the transaction table of the call
 	m_currCall->insertTransaction(m_currTransaction);
+	m_callMap->scheduleTransactionTimeout(m_currCall, m_currTransaction);
 
 	// Create SBA event and push it into the caller specific list
 	// in the SbaEventMap.
@@ -341,8 +435,9 @@ void SipProcessor::handleOptions() {
 	// set initial state of transaction
 	m_currTransaction->setState( { ts_TRYING, ts_TRYING });
 
-	// insert Transaction into TransactionMap object
+	// insert Transaction into the transaction table of the call
 	m_currCall->insertTransaction(m_currTransaction);
+	m_callMap->scheduleTransactionTimeout(m_currCall, m_currTransaction);
 
 	// Create SBA event and push it into the caller specific list
 	// in the SbaEventMap.
@@ -353,14 +448,11 @@ void SipProcessor::handleCancel() {
 
 	// Searching INVITE transaction to be canceled.
 
-	// Generate the TransactionId of the INVITE transaction that is requested
-	// to be canceled (same branch + request method INVITE)
-	TransactionId inviteTransactionId = { m_currTransaction->getId().first,
-			rm_INVITE };
-
-	// search the INVITE transaction
+	// The INVITE transaction that is requested to be canceled has the same
+	// branch and the request method INVITE.
 	shared_ptr<Transaction> inviteTransaction;
-	if (!m_currCall->findTransaction(inviteTransactionId, inviteTransaction)) {
+	if (!m_currCall->findTransaction(m_currTransaction->getBranchHash(),
+			m_currTransaction->getId().first, rm_INVITE, inviteTransaction)) {
 
 		// CANCEL request does not match an INVITE transaction
 		L_t<< "Transaction error: CANCEL request does not match an "
@@ -391,8 +483,9 @@ void SipProcessor::handleCancel() {
 	// setting initial state of the CANCEL transaction
 	m_currTransaction->setState( { ts_TRYING, ts_TRYING });
 
-	// insert CANCEL transaction into TransactionMap object
+	// insert CANCEL transaction into the transaction table of the call
 	m_currCall->insertTransaction(m_currTransaction);
+	m_callMap->scheduleTransactionTimeout(m_currCall, m_currTransaction);
 
 	// Create CANCEL event and push it into the caller specific list
 	// in the SbaEventMap.
@@ -440,7 +533,7 @@ void SipProcessor::handleAckOnNonSuccess() {
 	annulRtpSinks();
 
 	// delete the transaction (the INVITE transaction)
-	m_currCall->delTransaction(m_currTransaction->getId());
+	m_currCall->delTransaction(m_currTransaction);
 }
 
 void SipProcessor::handleAckOnSuccess() {
@@ -495,10 +588,10 @@ void SipProcessor::handleAckOnSuccess() {
 	confirmRtpSinks();
 
 	// delete the INVITE transaction
-	m_currCall->delTransaction(inviteTransaction->getId());
+	m_currCall->delTransaction(inviteTransaction);
 
 	// delete the ACK transaction
-	m_currCall->delTransaction(m_currTransaction->getId());
+	m_currCall->delTransaction(m_currTransaction);
 }
 
 void SipProcessor::handleProvisional() {
@@ -532,7 +625,8 @@ void SipProcessor::handleProvisionalOnInvite() {
 
 		// Add callee information to the Dialog.
 		m_currDialog->callee.tag = m_currPacket->getTo().tag;
-		m_currDialog->callee.displayname = m_currPacket->getTo().displayname;
+		m_currDialog->callee.displayname = m_internPool->intern(
+			m_currPacket->getTo().displayname);
 
 		// Early dialog if tag in the to-field is not empty.
 		if (m_currDialog->callee.tag != "") {
@@ -623,7 +717,8 @@ void SipProcessor::handleSuccessOnInvite() {
 	// Add callee information in Dialog, that is not available in initial
 	// INVITE request.
 	m_currDialog->callee.tag = m_currPacket->getTo().tag;
-	m_currDialog->callee.displayname = m_currPacket->getTo().displayname;
+	m_currDialog->callee.displayname = m_internPool->intern(
+				m_currPacket->getTo().displayname);
 
 	// Create INVITE SBA event and push it into the caller specific list
 	// in the SbaEventMap.
@@ -691,7 +786,7 @@ void SipProcessor::handleResponseOnBye() {
 	m_currTransaction->createAndPushEvent();
 
 	// delete the transaction
-	m_currCall->delTransaction(m_currTransaction->getId());
+	m_currCall->delTransaction(m_currTransaction);
 
 	// decode
 	prepareCallToDecode(m_currPacket->getCallId());
@@ -719,7 +814,7 @@ void SipProcessor::handleResponseOnOptions() {
 	m_currTransaction->createAndPushEvent();
 
 	// delete the transaction
-	m_currCall->delTransaction(m_currTransaction->getId());
+	m_currCall->delTransaction(m_currTransaction);
 }
 
 void SipProcessor::handleResponseOnCancel() {
@@ -744,7 +839,7 @@ void SipProcessor::handleResponseOnCancel() {
 	m_currTransaction->createAndPushEvent();
 
 	// delete the transaction
-	m_currCall->delTransaction(m_currTransaction->getId());
+	m_currCall->delTransaction(m_currTransaction);
 }
 
 void SipProcessor::processSdp() {
@@ -756,10 +851,27 @@ void SipProcessor::processSdp() {
 
 	L_t<< "Processing Session Description.";
 
+	const vector<SdpMediaStream>& streams = m_currPacket->getSdpMediaStreams();
+	for (auto iter = streams.begin(); iter != streams.end(); iter++) {
+
+		// Only audio streams are recorded. Port 0 marks a rejected stream,
+		// an unspecified address (e.g. 0.0.0.0) a stream on hold.
+		if (iter->media != "audio" || iter->socketAddress.getPort() == 0
+				|| iter->socketAddress.getIpAddress().is_unspecified()) {
+			L_t<< "Ignoring SDP media stream: " << iter->media << " "
+			<< iter->socketAddress;
+			continue;
+		}
+		processSdpMediaStream(*iter);
+	}
+}
+
+void SipProcessor::processSdpMediaStream(const SdpMediaStream& stream) {
+
 	// temp RTP sink
 	shared_ptr<RtpSink> rtpSink;
 
-	SocketAddress rtpSocket = m_currPacket->getSdpMediaSocket();
+	const SocketAddress& rtpSocket = stream.socketAddress;
 
 	// is re-INVITE? test if RTP sink already exists
 	if (m_currCall->getReinviteFlag()) {
@@ -777,6 +889,9 @@ void SipProcessor::processSdp() {
 				<< m_currPacket->getCallId();
 			}
 
+			// The re-INVITE may renegotiate the payload types.
+			rtpSink->setMediaFormat(stream.payloadTypeMap, stream.ptime);
+
 			// RtpSink object already exists (no change in socket address).
 			return;
 		}
@@ -796,7 +911,8 @@ void SipProcessor::processSdp() {
 	if (m_currCall->getDialog()->caller.tag == m_currPacket->getTo().tag)
 		isCallerSink = !isCallerSink;
 
-	rtpSink = make_shared<RtpSink>(isCallerSink);
+	rtpSink = make_shared<RtpSink>(isCallerSink, stream.payloadTypeMap,
+			stream.ptime);
 
 	// If the call has exceeded max_recording_time or (!)
 	// if record_if_incident_only is true (config) and there is no incident
@@ -886,12 +1002,7 @@ void SipProcessor::prepareCallToDecode(const string& callId) {
 }
 
 bool SipProcessor::callerHasIncident(const std::string &caller) {
-	std::shared_ptr<SbaIncidentSet> sbaIncidentSet;
-
-	if (m_sbaIncidentMap->find(caller, sbaIncidentSet)) {
-		return sbaIncidentSet->size();
-	}
-	return false;
+	return m_sbaIncidentMap->callerHasIncident(caller);
 }
 
 } /* namespace callx */
@@ -34,6 +34,7 @@
 #include "sip.hpp"
 #include "main/CallxThread.hpp"
 #include "main/CallxTypes.hpp"
+#include "SipPacketRecycler.hpp"
 
 namespace callx {
 
@@ -43,9 +44,14 @@ class RtpSinkMap;
 class Call;
 class Dialog;
 class SipPacket;
+struct SdpMediaStream;
 class SipPacketQueue;
 class CallDecodeQueue;
 class SbaIncidentMap;
+class SbaEventMap;
+class OodTransactionMap;
+class InternPool;
+class RetransmissionFilter;
 
 class SipProcessor:
         public CallxThread {
@@ -64,8 +70,27 @@ public:
      */
     void worker();
 
+    static u_int sipRetransmissionCount;
+
 protected:
 
+    /**
+     * Handles OPTIONS and REGISTER requests outside of a dialog and the
+     * responses to them. These transactions are tracked in the
+     * OodTransactionMap, the CallMap is not involved.
+     * @return True if the current SIP packet has been consumed.
+     */
+    bool handleOutOfDialog();
+
+    /**
+     * Creates an OptionsEvent for an out-of-dialog OPTIONS transaction and
+     * pushes it into the caller specific list in the SbaEventMap.
+     */
+    void pushOptionsEvent(const std::string& callId,
+            const SipIdentity& initiator,
+            u_int finalResponseCode,
+            const std::string& finalResponseReason);
+
     void handleInitialRequest();
     void handleRequestWithinTransaction();
     void handleResponse();
@@ -92,10 +117,15 @@ protected:
 
     /**
      * Creates SDP sinks and inserts them into local (Call) and global
-     * RtpSinkMap.
+     * RtpSinkMap, one per audio stream of the session description.
      */
     void processSdp();
 
+    /**
+     * Creates or updates the RtpSink of one SDP media stream.
+     */
+    void processSdpMediaStream(const SdpMediaStream& stream);
+
     /**
      * Deletes all RtpSink from local RtpSink map with status CONFIRMED.
      * Changes the status of RtpSinks with status INIT or CONFIRMED_INIT to
@@ -133,7 +163,7 @@ protected:
     /**
      * Test if there is an incident originated by this caller.
      * @param caller address, eg. sip:blah@blubb
-     * @return true if there is at least one incident
+     * @return true if there was an incident at the last SBA run
      */
     bool callerHasIncident(const std::string& caller);
 
@@ -143,8 +173,12 @@ protected:
     RtpSinkMap *m_rtpSinkMap;
     CallDecodeQueue *m_callDecodeQueue;
     SbaIncidentMap *m_sbaIncidentMap;
+    SbaEventMap *m_sbaEventMap;
+    OodTransactionMap *m_oodTransactionMap;
+    InternPool *m_internPool;
+    std::unique_ptr<RetransmissionFilter> m_retransmissionFilter;
 
-    std::unique_ptr<SipPacket> m_currPacket;
+    std::unique_ptr<SipPacket, SipPacketRecycler> m_currPacket;
     std::shared_ptr<Call> m_currCall;
     std::unique_ptr<unique_lock> m_currCallLock;
     std::shared_ptr<Transaction> m_currTransaction;
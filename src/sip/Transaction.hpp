@@ -32,23 +32,47 @@
 #define TRANSACTION_HPP_
 
 #include "sip/SipPacket.hpp"
+#include "sip/SipPacketRecycler.hpp"
 #include "Call.hpp"
 #include "container/SbaEventMap.hpp"
+#include "container/InternPool.hpp"
+#include <boost/pool/pool_alloc.hpp>
 
 namespace callx {
 
+class Transaction;
+
+/**
+ * Transaction objects come and go at SIP message rate. They are allocated
+ * together with their shared_ptr control block from a singleton pool.
+ */
+typedef boost::fast_pool_allocator<Transaction> TransactionAllocator;
+
 class Transaction {
 public:
 
+    /**
+     * Creates a pool allocated Transaction object.
+     * @param call
+     * @param sipPacket The request initiating the transaction.
+     * @return
+     */
+    static std::shared_ptr<Transaction> create(std::weak_ptr<Call> call,
+            const std::unique_ptr<SipPacket, SipPacketRecycler>& sipPacket) {
+        return std::allocate_shared<Transaction>(TransactionAllocator(),
+                call, sipPacket);
+    }
+
     Transaction(std::weak_ptr<Call> call,
-            const std::unique_ptr<SipPacket>& sipPacket)
+            const std::unique_ptr<SipPacket, SipPacketRecycler>& sipPacket)
             : m_creationTs(systemClock::now()),
               m_activityTs(steadyClock::now()),
               m_call(call),
-              m_initiator(sipPacket->getFrom()),
+              m_initiator(InternPool::getInstance()->intern(sipPacket->getFrom())),
               m_sentBy(sipPacket->getSentBy()),
               m_cseqNum(sipPacket->getCseqNum()),
               m_id( { sipPacket->getBranch(), sipPacket->getCseqMethod() }),
+              m_branchHash(sipPacket->getBranchHash()),
               m_state( { ts_TERMINATED, ts_TERMINATED }),
               m_finalResponseCode(0),
               m_cancelFlag(false),
@@ -72,7 +96,7 @@ public:
         return m_activityTs;
     }
 
-    const SipFromTo& getInitiator() {
+    const SipIdentity& getInitiator() {
         return m_initiator;
     }
 
@@ -88,6 +112,10 @@ public:
         return m_id;
     }
 
+    size_t getBranchHash() const {
+        return m_branchHash;
+    }
+
     const TransactionState& getState() const {
         return m_state;
     }
@@ -191,13 +219,8 @@ protected:
      * @param caller
      * @param event
      */
-    void pushEvent(const std::string &caller, SbaEvent *event) {
-        std::shared_ptr<SbaEventDeque> eventDeque;
-        if (!m_sbaEventMap->find(caller, eventDeque)) {
-            eventDeque = std::make_shared<SbaEventDeque>();
-            m_sbaEventMap->insert(std::make_pair(caller, eventDeque));
-        }
-        eventDeque->push_back(std::shared_ptr<SbaEvent>(event));
+    void pushEvent(InternId caller, SbaEvent *event) {
+        m_sbaEventMap->pushEvent(caller, std::shared_ptr<SbaEvent>(event));
     }
 
     SbaEventMap *m_sbaEventMap;
@@ -206,10 +229,11 @@ protected:
     steadyClock::time_point m_activityTs; // activity Timestamp
 
     std::weak_ptr<Call> m_call;
-    SipFromTo m_initiator;
+    SipIdentity m_initiator;
     std::string m_sentBy;
     u_int m_cseqNum;
     TransactionId m_id;
+    size_t m_branchHash;
     TransactionState m_state;
     u_int m_finalResponseCode;
     std::string m_finalResponseReason;
@@ -31,12 +31,14 @@
 #include "Watchdog.hpp"
 #include "main/callx.hpp"
 #include "container/CallMap.hpp"
+#include "container/OodTransactionMap.hpp"
 #include "boost/thread.hpp"
 
 namespace callx {
 
 Watchdog::Watchdog()
-        : m_callMap(CallMap::getInstance()) {
+        : m_callMap(CallMap::getInstance()),
+          m_oodTransactionMap(OodTransactionMap::getInstance()) {
     L_t
     << "C'tor";
     classname = "Watchdog";
@@ -56,10 +58,14 @@ void Watchdog::worker() {
         // std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
         // the boost variant
-        boost::this_thread::sleep(boost::posix_time::milliseconds(500));
+        boost::this_thread::sleep(boost::posix_time::milliseconds(
+                TimeoutWheel::Tick_Milliseconds));
 
         m_callMap->handleCallTimeouts();
 
+        // out-of-dialog transactions expire without further requests, too
+        m_oodTransactionMap->handleTimeouts();
+
     } // while (!m_stopRequested)
 
     L_t
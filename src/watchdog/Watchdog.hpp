@@ -36,6 +36,7 @@
 namespace callx {
 
 class CallMap;
+class OodTransactionMap;
 
 class Watchdog: public CallxThread {
 public:
@@ -52,6 +53,7 @@ private:
     void deleteOutdatedCalls();
 
     CallMap *m_callMap;
+    OodTransactionMap *m_oodTransactionMap;
 
 };
 
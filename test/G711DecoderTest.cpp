@@ -0,0 +1,135 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * G711DecoderTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "audio/G711Decoder.hpp"
+#include "check.hpp"
+#include <vector>
+
+using namespace callx;
+
+namespace {
+
+// Compares a kernel with the decoding table for all 256 codes, at every
+// length up to 100 and every offset up to 31, so that the vector loops,
+// their scalar tails and unaligned buffers are covered.
+void testKernel(const std::string& name, bool alaw) {
+    G711Decoder::Kernel kernel = G711Decoder::kernel(name, alaw);
+    if (!kernel) {
+        std::cout << name << " not available, skipped" << std::endl;
+        return;
+    }
+    const short* decodeTab = G711Decoder::decodeTable(alaw);
+
+    std::vector<u_char> codes(256 + 32 + 100);
+    for (size_t i = 0; i < codes.size(); i++) {
+        codes[i] = u_char(i * 37);
+    }
+
+    // all codes at once
+    std::vector<u_char> all(256);
+    for (size_t i = 0; i < all.size(); i++) {
+        all[i] = u_char(i);
+    }
+    std::vector<short> out(all.size());
+    kernel(decodeTab, all.data(), all.size(), out.data());
+    for (size_t i = 0; i < all.size(); i++) {
+        CHECK(out[i] == decodeTab[i]);
+    }
+
+    // odd lengths and unaligned buffers, the sample behind must survive
+    std::vector<short> buffer(32 + 100 + 1);
+    for (size_t offset = 0; offset < 32; offset++) {
+        for (size_t n = 0; n <= 100; n++) {
+            buffer.assign(buffer.size(), 0x5A5A);
+            kernel(decodeTab, codes.data() + offset, n,
+                    buffer.data() + offset);
+            for (size_t i = 0; i < n; i++) {
+                CHECK(buffer[offset + i] == decodeTab[codes[offset + i]]);
+            }
+            CHECK(buffer[offset + n] == 0x5A5A);
+        }
+    }
+}
+
+// The decoder object uses the selected kernel.
+void testDecoder(bool alaw) {
+    G711Decoder decoder(alaw);
+    std::vector<u_char> in(1000);
+    for (size_t i = 0; i < in.size(); i++) {
+        in[i] = u_char(i * 13 + 7);
+    }
+    std::vector<short> out(in.size());
+    CHECK(decoder.decode(in.data(), in.size(), out.data())
+            == in.size() * sizeof(short));
+    const short* decodeTab = G711Decoder::decodeTable(alaw);
+    for (size_t i = 0; i < in.size(); i++) {
+        CHECK(out[i] == decodeTab[in[i]]);
+    }
+}
+
+// Payloads are split into whole frames of inBufSize, G.711 has no framing:
+// payloads of any length, e.g. 25 ms (200 bytes), decode completely.
+void testPayloadSizes(bool alaw) {
+    G711Decoder decoder(alaw);
+    const short* decodeTab = G711Decoder::decodeTable(alaw);
+    const size_t sizes[] = { 1, 33, 80, 200, 239 };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        std::vector<u_char> in(sizes[s]);
+        for (size_t i = 0; i < in.size(); i++) {
+            in[i] = u_char(i * 29 + 3);
+        }
+        size_t frames = in.size() / decoder.inBufSize;
+        CHECK(frames * decoder.inBufSize == in.size());
+
+        std::vector<short> out(in.size() + 1, 0x5A5A);
+        CHECK(decoder.decode(in.data(), frames * decoder.inBufSize,
+                out.data()) == frames * decoder.outBufSize);
+        CHECK(frames * decoder.outBufSize == in.size() * sizeof(short));
+        for (size_t i = 0; i < in.size(); i++) {
+            CHECK(out[i] == decodeTab[in[i]]);
+        }
+        CHECK(out[in.size()] == 0x5A5A);
+    }
+}
+
+} /* namespace */
+
+int main() {
+    const char* kernels[] = { "avx2", "sse4.1", "scalar" };
+    for (size_t k = 0; k < 3; k++) {
+        testKernel(kernels[k], true);
+        testKernel(kernels[k], false);
+    }
+    CHECK(G711Decoder::kernel("none", true) == NULL);
+    testDecoder(true);
+    testDecoder(false);
+    testPayloadSizes(true);
+    testPayloadSizes(false);
+    return CHECK_RESULT;
+}
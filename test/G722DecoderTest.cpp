@@ -0,0 +1,215 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * G722DecoderTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "audio/G722Decoder.hpp"
+#include "check.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace callx;
+
+namespace {
+
+/*
+ * 40 ms of a two-tone signal, 800 Hz (6000) in the lower and 5500 Hz (2000)
+ * in the higher sub-band, at 16 kHz:
+ *
+ *   x(n) = round(6000 sin(2 pi 800 n / 16000) + 2000 sin(2 pi 5500 n / 16000))
+ *
+ * encoded with 64 kbit/s G.722 by a separate model of the ITU-T G.722
+ * function blocks, and the PCM that model decodes from the codewords. The
+ * ITU test sequences are not part of the tree.
+ */
+const u_char g722Codes[320] = {
+        250, 88, 119, 163, 8, 160, 160, 32, 32, 170, 186, 18, 140, 141,
+        20, 191, 177, 44, 45, 178, 63, 22, 146, 19, 25, 189, 243, 48,
+        176, 245, 63, 215, 148, 84, 89, 189, 115, 112, 176, 117, 126, 151,
+        213, 20, 218, 252, 51, 241, 241, 118, 95, 153, 85, 85, 154, 123,
+        116, 176, 240, 54, 223, 216, 83, 215, 156, 61, 116, 240, 113, 118,
+        158, 87, 21, 213, 91, 60, 244, 240, 113, 248, 159, 24, 82, 214,
+        90, 125, 180, 113, 50, 248, 126, 22, 212, 212, 88, 255, 180, 47,
+        116, 244, 127, 87, 151, 85, 23, 249, 119, 51, 242, 247, 126, 217,
+        148, 20, 88, 253, 116, 111, 180, 114, 31, 221, 84, 84, 215, 247,
+        59, 239, 181, 50, 125, 222, 84, 85, 218, 122, 55, 177, 239, 55,
+        249, 94, 86, 216, 152, 125, 114, 177, 46, 116, 247, 90, 90, 215,
+        159, 63, 181, 239, 113, 241, 120, 94, 24, 150, 29, 125, 243, 113,
+        237, 114, 249, 62, 150, 155, 94, 253, 115, 113, 236, 174, 126, 63,
+        218, 26, 94, 124, 115, 47, 110, 240, 52, 255, 92, 88, 93, 183,
+        116, 106, 176, 108, 117, 251, 90, 63, 220, 246, 51, 237, 235, 116,
+        111, 157, 123, 92, 189, 54, 49, 109, 108, 110, 251, 248, 60, 221,
+        159, 117, 244, 235, 116, 236, 181, 127, 29, 156, 220, 248, 241, 240,
+        109, 177, 183, 30, 127, 88, 222, 249, 179, 114, 45, 242, 121, 124,
+        221, 88, 28, 250, 179, 113, 236, 241, 122, 254, 153, 91, 60, 253,
+        115, 114, 173, 242, 125, 253, 154, 89, 221, 187, 54, 109, 112, 112,
+        123, 154, 222, 25, 218, 118, 120, 236, 175, 125, 245, 159, 25, 88,
+        91, 117, 52, 239, 120, 47, 220, 125, 89, 216, 157, 52, 117, 238,
+        117, 241, 251, 90, 30, 155, 253, 55, 247, 111, 241, 243
+};
+
+const short g722Pcm[640] = {
+        0, -1, -1, 0, 0, -1, 0, 0, -1, -1,
+        1, 0, 0, -2, -8, -23, 15, 47, -9, -94,
+        -56, 78, 296, 513, 661, 1049, 2204, 3684, 4691, 4552,
+        3444, 1820, -15, -1789, -3364, -4852, -5880, -6065, -5810, -4990,
+        -3452, -1758, -85, 1896, 3410, 4776, 5863, 5551, 5614, 5111,
+        3476, 1846, 464, -2335, -3328, -4367, -6142, -6191, -4840, -5805,
+        -3205, -1238, -1271, 2780, 4133, 3507, 6562, 6875, 3886, 5884,
+        3904, 115, 1735, -2137, -5110, -2717, -6890, -6407, -4017, -5970,
+        -3876, 78, -1879, 2010, 5192, 3375, 5840, 7869, 3796, 5284,
+        4989, 345, 222, -316, -5773, -3502, -4686, -8689, -3875, -4624,
+        -5377, -130, 156, -438, 5914, 4739, 4051, 7766, 5201, 4139,
+        5207, 843, -579, 110, -5104, -4885, -3985, -7364, -5773, -3220,
+        -5344, -1610, 1291, 307, 3899, 6207, 3380, 7230, 6866, 2377,
+        5307, 2301, -1912, -355, -3658, -6171, -4404, -6582, -7050, -2647,
+        -4426, -3286, 2570, 570, 2990, 6538, 4606, 5985, 7223, 3419,
+        3556, 3636, -1989, -1583, -1947, -7204, -4689, -5378, -7526, -3784,
+        -2565, -4182, 1621, 2256, 1624, 6551, 5610, 4781, 7244, 4417,
+        2229, 3823, -810, -3204, -1104, -6134, -6440, -4439, -7019, -4995,
+        -2026, -3430, 4, 3627, 1608, 5106, 7253, 3836, 6835, 5719,
+        1712, 2877, 840, -4068, -1839, -4525, -7765, -4303, -5793, -6165,
+        -1904, -2277, -1231, 3868, 2753, 3576, 8093, 4819, 5049, 6540,
+        2198, 1718, 1566, -3462, -3477, -3086, -7578, -5641, -4153, -7072,
+        -2537, -980, -1803, 3026, 4346, 2596, 7356, 6405, 3719, 6561,
+        3333, 456, 1706, -2347, -4833, -2905, -6542, -7285, -3441, -6119,
+        -4225, -73, -1338, 1685, 5111, 3203, 5791, 7710, 3721, 5203,
+        5065, -383, 954, -944, -5449, -3827, -5071, -7680, -4449, -4610,
+        -5094, -466, 90, 418, 4997, 4658, 4469, 7722, 5091, 3529,
+        5622, 666, -817, 202, -5013, -5293, -3882, -7723, -5557, -3396,
+        -5204, -1398, 1197, 189, 4281, 5763, 3947, 7215, 6363, 2767,
+        5106, 2083, -1841, -193, -3511, -6420, -3904, -6256, -7133, -2958,
+        -4397, -2782, 1825, 761, 2961, 6578, 4401, 5446, 7550, 3117,
+        3513, 3554, -1837, -1571, -2034, -6645, -5142, -4993, -7639, -3638,
+        -2884, -3756, 1438, 2268, 1523, 6620, 5617, 4322, 7702, 4382,
+        2177, 3690, -664, -2909, -1528, -5999, -6389, -4019, -7064, -5511,
+        -1458, -3599, -142, 3663, 1566, 5192, 7190, 3989, 6426, 5959,
+        1671, 2649, 841, -3471, -2534, -4240, -7614, -4320, -5837, -6483,
+        -1627, -2460, -1201, 3871, 2661, 3790, 7634, 4920, 4837, 6873,
+        2184, 1415, 1914, -3733, -3336, -3205, -7481, -5908, -4068, -6847,
+        -2861, -825, -1852, 2834, 4397, 2831, 7220, 6334, 4009, 6491,
+        3610, 220, 1878, -2330, -4821, -3078, -6419, -6854, -3921, -6036,
+        -4127, 109, -1475, 1448, 5350, 3274, 5578, 7633, 3867, 5274,
+        4989, -240, 810, -755, -5546, -3761, -4806, -8099, -4298, -4405,
+        -5455, -215, 170, 59, 5333, 4594, 4276, 7975, 5068, 3818,
+        5489, 763, -636, 76, -5010, -5100, -4016, -7685, -5594, -3369,
+        -5219, -1532, 1559, -336, 4432, 5935, 3634, 7061, 6433, 2984,
+        4997, 2183, -1774, -359, -3543, -6320, -3977, -6444, -6981, -2862,
+        -4452, -2853, 1974, 624, 2894, 6779, 4149, 5704, 7397, 3262,
+        3558, 3385, -1649, -1537, -2151, -6684, -5097, -4687, -7861, -3842,
+        -2612, -3877, 1318, 2284, 1630, 6575, 5657, 4378, 7369, 4596,
+        2072, 3759, -551, -3227, -1421, -5854, -6640, -4054, -7095, -5222,
+        -1741, -3432, -93, 3541, 1678, 5150, 7201, 3920, 6603, 5784,
+        1557, 3149, 601, -3839, -1956, -4617, -7506, -4298, -5732, -6548,
+        -1671, -2219, -1503, 3929, 2707, 3698, 7742, 4829, 4952, 6861,
+        2045, 1518, 1796, -3511, -3497, -3253, -7522, -5670, -4321, -6797,
+        -2719, -865, -1904, 3013, 4216, 2959, 7043, 6454, 3869, 6469,
+        3563, 241, 1718, -2169, -4897, -2980, -6436, -7010, -3864, -5978,
+        -4257, 92, -1400, 1370, 5521, 3167, 5744, 7633, 3850, 5201,
+        4917, -25, 608, -680, -5499, -3904, -4827, -7966, -4317, -4454,
+        -5323, -264, 8, 241, 5306, 4475, 4311, 7990, 4792, 3847,
+        5490, 669, -700, 61, -4923, -5317, -3765, -7698, -5686, -3252,
+        -5360, -1505, 1448, -193, 4363, 5973, 3699, 7143, 6492, 2821,
+        5014, 2088, -1786, -144, -3679, -6387, -3854, -6483, -7064, -2861,
+        -4311, -3042, 2152, 717, 2744, 6865, 4286, 5641, 7508, 3175,
+        3598, 3433, -1788, -1495, -2226, -6671, -4985, -4994, -7570, -3778
+};
+
+short tone(size_t n) {
+    return short(lround(6000 * sin(2 * M_PI * 800 * n / 16000)
+            + 2000 * sin(2 * M_PI * 5500 * n / 16000)));
+}
+
+// The whole vector in one call.
+void testVector() {
+    G722Decoder decoder;
+    CHECK(decoder.sampleRate == 16000);
+    std::vector<short> out(640);
+    CHECK(decoder.decode(g722Codes, 320, out.data()) == 640 * sizeof(short));
+    for (size_t i = 0; i < out.size(); i++) {
+        CHECK(out[i] == g722Pcm[i]);
+    }
+}
+
+// Payloads of any length continue the decoder state, reset() restarts it.
+void testPayloadSizes() {
+    G722Decoder decoder;
+    const size_t sizes[] = { 1, 7, 80, 33, 160, 39 };
+    std::vector<short> out(640);
+    for (int pass = 0; pass < 2; pass++) {
+        out.assign(out.size(), 0x5A5A);
+        size_t pos = 0;
+        for (size_t s = 0; pos < 320; s = (s + 1) % 6) {
+            size_t size = std::min(sizes[s], 320 - pos);
+            size_t frames = size / decoder.inBufSize;
+            CHECK(frames * decoder.inBufSize == size);
+            CHECK(decoder.decode(g722Codes + pos, size, out.data() + 2 * pos)
+                    == frames * decoder.outBufSize);
+            pos += size;
+        }
+        for (size_t i = 0; i < out.size(); i++) {
+            CHECK(out[i] == g722Pcm[i]);
+        }
+        decoder.reset();
+    }
+
+    // one frame at a time through the frame interface
+    for (size_t pos = 0; pos < 320; pos += decoder.inBufSize) {
+        decoder.decode(const_cast<u_char*>(g722Codes + pos), &out[2 * pos]);
+    }
+    for (size_t i = 0; i < out.size(); i++) {
+        CHECK(out[i] == g722Pcm[i]);
+    }
+}
+
+// The decoded signal is the input, 22 samples late (both QMFs), once the
+// adaptation settled after 10 ms.
+void testTone() {
+    G722Decoder decoder;
+    std::vector<short> out(640);
+    decoder.decode(g722Codes, 320, out.data());
+    const size_t delay = 22;
+    double signal = 0;
+    double noise = 0;
+    for (size_t n = 160; n + delay < out.size(); n++) {
+        double x = tone(n);
+        double e = out[n + delay] - x;
+        signal += x * x;
+        noise += e * e;
+    }
+    CHECK(noise > 0 && 10 * log10(signal / noise) > 30);
+}
+
+} /* namespace */
+
+int main() {
+    testVector();
+    testPayloadSizes();
+    testTone();
+    return CHECK_RESULT;
+}
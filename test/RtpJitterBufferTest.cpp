@@ -0,0 +1,159 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * RtpJitterBufferTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "audio/RtpJitterBuffer.hpp"
+#include "check.hpp"
+#include <vector>
+
+using namespace callx;
+
+namespace {
+
+struct Popped {
+    u_short seqNum;
+    u_int missing;
+    bool restart;
+};
+
+u_char payload[160];
+
+void push(RtpJitterBuffer& jitterBuffer, u_short seqNum) {
+    RtpPayload rtpPayload;
+    rtpPayload.seqNum = seqNum;
+    rtpPayload.timestamp = seqNum * 160;
+    rtpPayload.ssrc = 1;
+    rtpPayload.payloadType = 0;
+    rtpPayload.data = payload;
+    rtpPayload.size = sizeof(payload);
+    jitterBuffer.push(rtpPayload);
+}
+
+std::vector<Popped> popAll(RtpJitterBuffer& jitterBuffer) {
+    std::vector<Popped> popped;
+    RtpPayload rtpPayload;
+    Popped entry;
+    while (jitterBuffer.pop(rtpPayload, entry.missing, entry.restart, true)) {
+        entry.seqNum = rtpPayload.seqNum;
+        popped.push_back(entry);
+    }
+    return popped;
+}
+
+// A jump followed by reordered packets: one restart, then the reordering
+// is repaired on the new numbering.
+void testRestartThenReorder() {
+    RtpJitterBuffer jitterBuffer;
+    for (u_short seqNum = 100; seqNum <= 110; seqNum++) {
+        push(jitterBuffer, seqNum);
+    }
+    const u_short after[] = { 40000, 40001, 40003, 40002, 40004 };
+    for (size_t i = 0; i < 5; i++) {
+        push(jitterBuffer, after[i]);
+    }
+
+    std::vector<Popped> popped = popAll(jitterBuffer);
+    CHECK(popped.size() == 16);
+    if (popped.size() != 16)
+        return;
+    for (size_t i = 0; i < 11; i++) {
+        CHECK(popped[i].seqNum == 100 + i);
+        CHECK(!popped[i].restart);
+    }
+    for (size_t i = 11; i < 16; i++) {
+        CHECK(popped[i].seqNum == 40000 + i - 11);
+        CHECK(popped[i].restart == (i == 11));
+        CHECK(popped[i].missing == 0);
+    }
+    CHECK(jitterBuffer.stats().reordered == 1);
+    CHECK(jitterBuffer.stats().lost == 0);
+}
+
+// Loss after a restart is counted on the new numbering.
+void testRestartThenLoss() {
+    RtpJitterBuffer jitterBuffer;
+    push(jitterBuffer, 65000);
+    push(jitterBuffer, 65001);
+    push(jitterBuffer, 30000);
+    push(jitterBuffer, 30001);
+    push(jitterBuffer, 30003);
+
+    std::vector<Popped> popped = popAll(jitterBuffer);
+    CHECK(popped.size() == 5);
+    if (popped.size() != 5)
+        return;
+    CHECK(popped[2].seqNum == 30000 && popped[2].restart);
+    CHECK(popped[4].seqNum == 30003 && !popped[4].restart);
+    CHECK(popped[4].missing == 1);
+    CHECK(jitterBuffer.stats().lost == 1);
+}
+
+// A single packet far off does not restart the stream.
+void testStrayPacket() {
+    RtpJitterBuffer jitterBuffer;
+    for (u_short seqNum = 100; seqNum <= 105; seqNum++) {
+        push(jitterBuffer, seqNum);
+    }
+    push(jitterBuffer, 50000);
+    for (u_short seqNum = 106; seqNum <= 110; seqNum++) {
+        push(jitterBuffer, seqNum);
+    }
+    push(jitterBuffer, 60000);
+
+    std::vector<Popped> popped = popAll(jitterBuffer);
+    CHECK(popped.size() == 11);
+    for (size_t i = 0; i < popped.size(); i++) {
+        CHECK(popped[i].seqNum == 100 + i);
+        CHECK(!popped[i].restart && popped[i].missing == 0);
+    }
+    CHECK(jitterBuffer.stats().discarded == 1);
+}
+
+// Sequence number wraparound is no restart.
+void testWraparound() {
+    RtpJitterBuffer jitterBuffer;
+    for (u_int i = 0; i < 20; i++) {
+        push(jitterBuffer, u_short(65530 + i));
+    }
+
+    std::vector<Popped> popped = popAll(jitterBuffer);
+    CHECK(popped.size() == 20);
+    for (size_t i = 0; i < popped.size(); i++) {
+        CHECK(!popped[i].restart);
+    }
+}
+
+} /* namespace */
+
+int main() {
+    testRestartThenReorder();
+    testRestartThenLoss();
+    testStrayPacket();
+    testWraparound();
+    return CHECK_RESULT;
+}
@@ -0,0 +1,184 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * VoiceActivityDetectorTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include "audio/VoiceActivityDetector.hpp"
+#include "audio/MemChunk.hpp"
+#include "audio/MemChunkPool.hpp"
+#include "check.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace callx;
+
+namespace {
+
+const int Threshold_Db = -45;
+
+// quiet noise, well below the threshold
+void appendSilence(std::vector<short>& samples, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        samples.push_back(short(i % 7) - 3);
+    }
+}
+
+void appendTone(std::vector<short>& samples, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        samples.push_back(short(3000 * sin(i * 0.2)));
+    }
+}
+
+std::vector<short> samplesOf(PcmAudio& pcmAudio) {
+    std::vector<short> samples;
+    auto memChunkDeque = pcmAudio.getChunkDeque();
+    for (auto iter = memChunkDeque->begin(); iter != memChunkDeque->end();
+            iter++) {
+        const short* data = reinterpret_cast<const short*>((*iter)->data());
+        samples.insert(samples.end(), data,
+                data + (*iter)->fillingLevel() / sizeof(short));
+    }
+    return samples;
+}
+
+// Runs the detector on 8 kHz audio, returns the samples removed.
+size_t process(PcmAudio& pcmAudio, const std::vector<short>& samples,
+        u_short channels, u_int maxSilenceMs) {
+    pcmAudio.setSampleRate(8000);
+    pcmAudio.setChannels(channels);
+    pcmAudio.append(samples.data(), samples.size());
+    VoiceActivityDetector vad(Threshold_Db, maxSilenceMs);
+    return vad.process(pcmAudio);
+}
+
+// Silence only, dropped entirely: no MemChunk and no silence marker is left.
+void testSilenceDropped() {
+    std::vector<short> in;
+    appendSilence(in, 10000);
+    PcmAudio pcmAudio("id", SipIdentity(), SipIdentity(), systemClock::now(),
+            true);
+    CHECK(process(pcmAudio, in, 1, 0) == 10000);
+    CHECK(pcmAudio.getChunkDeque()->empty());
+    CHECK(pcmAudio.voicedEnd(1) == 1);
+    CHECK(MemChunkPool::getInstance()->inUse() == 0);
+}
+
+// Silence only, shortened to 100 ms: the start is kept and marked.
+void testSilenceShortened() {
+    std::vector<short> in;
+    appendSilence(in, 10000);
+    PcmAudio pcmAudio("id", SipIdentity(), SipIdentity(), systemClock::now(),
+            true);
+    CHECK(process(pcmAudio, in, 1, 100) == 10000 - 800);
+    std::vector<short> out = samplesOf(pcmAudio);
+    CHECK(out == std::vector<short>(in.begin(), in.begin() + 800));
+    CHECK(pcmAudio.voicedEnd(1) == 801);
+}
+
+// Voice that does not end on a frame boundary is kept completely.
+void testPartialFrame() {
+    std::vector<short> in;
+    appendTone(in, 8000 + 37);
+    PcmAudio pcmAudio("id", SipIdentity(), SipIdentity(), systemClock::now(),
+            true);
+    CHECK(process(pcmAudio, in, 1, 0) == 0);
+    CHECK(samplesOf(pcmAudio) == in);
+    CHECK(pcmAudio.voicedEnd(1) == 1);
+}
+
+// A stereo stream cut off within a sample keeps its last channel.
+void testPartialChannels() {
+    std::vector<short> voiced;
+    appendTone(voiced, 2 * 1000 + 1);
+    PcmAudio voicedAudio("id", SipIdentity(), SipIdentity(),
+            systemClock::now(), true);
+    CHECK(process(voicedAudio, voiced, 2, 0) == 0);
+    CHECK(samplesOf(voicedAudio) == voiced);
+
+    std::vector<short> silent;
+    appendSilence(silent, 2 * 500 + 1);
+    PcmAudio droppedAudio("id", SipIdentity(), SipIdentity(),
+            systemClock::now(), true);
+    CHECK(process(droppedAudio, silent, 2, 0) == 500);
+    CHECK(samplesOf(droppedAudio) == std::vector<short>(1, silent.back()));
+    CHECK(droppedAudio.voicedEnd(1) == 1);
+
+    silent.clear();
+    appendSilence(silent, 2 * 2000 + 1);
+    PcmAudio shortenedAudio("id", SipIdentity(), SipIdentity(),
+            systemClock::now(), true);
+    CHECK(process(shortenedAudio, silent, 2, 100) == 2000 - 800);
+    std::vector<short> expected(silent.begin(), silent.begin() + 2 * 800);
+    expected.push_back(silent.back());
+    CHECK(samplesOf(shortenedAudio) == expected);
+    CHECK(shortenedAudio.voicedEnd(1) == 801);
+}
+
+// The channels of a stereo call keep the silence spans, so the limit of
+// voiced audio is the same for the stereo audio and for each channel.
+void testStereoChannels() {
+    std::vector<short> mono;
+    appendTone(mono, 8000);
+    appendSilence(mono, 16000);
+    appendTone(mono, 8000);
+    std::vector<short> stereo;
+    for (size_t i = 0; i < mono.size(); i++) {
+        stereo.push_back(mono[i]);
+        stereo.push_back(-mono[i]);
+    }
+    PcmAudio stereoAudio("id", SipIdentity(), SipIdentity(),
+            systemClock::now(), true);
+    size_t hangover = VoiceActivityDetector::Hangover_Frames * 80;
+    CHECK(process(stereoAudio, stereo, 2, 100) == 16000 - hangover - 800);
+
+    // 1.5 s of voice reach past the 800 samples of kept silence
+    size_t maxSamples = stereoAudio.voicedEnd(12000);
+    CHECK(maxSamples == 12000 + 800);
+    std::vector<short> out = samplesOf(stereoAudio);
+    for (u_short channel = 0; channel < 2; channel++) {
+        PcmAudio channelAudio("id", SipIdentity(), SipIdentity(),
+                systemClock::now(), channel == 0);
+        stereoAudio.copyChannel(channel, maxSamples, channelAudio);
+        std::vector<short> samples = samplesOf(channelAudio);
+        CHECK(samples.size() == maxSamples);
+        for (size_t i = 0; i < samples.size(); i++) {
+            CHECK(samples[i] == out[2 * i + channel]);
+        }
+        CHECK(channelAudio.voicedEnd(12000) == maxSamples);
+    }
+}
+
+} /* namespace */
+
+int main() {
+    testSilenceDropped();
+    testSilenceShortened();
+    testPartialFrame();
+    testPartialChannels();
+    testStereoChannels();
+    return CHECK_RESULT;
+}
@@ -0,0 +1,53 @@
+/**
+ * This file is part of callx. The application callx performs the call
+ * extraction as well as the signaling-based analysis in the VIAT system.
+ *
+ * http://viat.fh-koeln.de
+ *
+ * Copyright (C) 2013 Bernhard Mainka (mail@bmainka.de),
+ * Cologne University of Applied Sciences
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * check.hpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef CHECK_HPP_
+#define CHECK_HPP_
+
+#include <iostream>
+
+/*
+ * Minimal checks for the unit tests: a failed CHECK prints the condition
+ * and its location, CHECK_RESULT is the exit code of the test.
+ */
+
+static int checkFailures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond \
+                      << ") failed" << std::endl; \
+            checkFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_RESULT (checkFailures ? 1 : 0)
+
+#endif /* CHECK_HPP_ */